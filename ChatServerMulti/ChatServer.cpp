@@ -1,6 +1,7 @@
 #include "ChatServer.h"
 #include "NetLibrary/Logger/Logger.h"
 #include <vector>
+#include <process.h>
 
 Player* ChatServer::findPlayerOrNull(const uint64_t sessionID)
 {
@@ -15,6 +16,87 @@ Player* ChatServer::findPlayerOrNull(const uint64_t sessionID)
 	return player;
 }
 
+void ChatServer::Start(const uint16_t port, const uint32_t maxSessionCount, const uint32_t iocpConcurrentThreadCount, const uint32_t iocpWorkerThreadCount)
+{
+	ASSERT_LIVE(mTimeoutCheckInterval > 0, L"TIMEOUT_CHECK_INTERVAL can not be zero");
+
+	// keep the wheel's tick count continuous across restarts
+	mTimeoutBaseTick = ::GetTickCount64() - mTimeoutWheel.GetCurrentTick() * mTimeoutCheckInterval;
+	mTimeoutThreadExitEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+
+	NetServer::Start(port, maxSessionCount, iocpConcurrentThreadCount, iocpWorkerThreadCount);
+
+	mTimeoutThread = reinterpret_cast<HANDLE>(::_beginthreadex(nullptr, 0, timeoutThread, this, 0, nullptr));
+
+	LOGF(ELogLevel::System, L"Timeout (check interval = %u ms, logged in = %u ms, not logged in = %u ms)", mTimeoutCheckInterval, mTimeoutLoggedIn, mTimeoutNotLoggedIn);
+}
+
+void ChatServer::Shutdown(void)
+{
+	::SetEvent(mTimeoutThreadExitEvent);
+	::WaitForSingleObject(mTimeoutThread, INFINITE);
+
+	::CloseHandle(mTimeoutThread);
+	::CloseHandle(mTimeoutThreadExitEvent);
+	mTimeoutThread = nullptr;
+	mTimeoutThreadExitEvent = nullptr;
+
+	NetServer::Shutdown();
+}
+
+unsigned int ChatServer::timeoutThread(void* chatServerParam)
+{
+	ChatServer* chatServer = reinterpret_cast<ChatServer*>(chatServerParam);
+
+	while (::WaitForSingleObject(chatServer->mTimeoutThreadExitEvent, chatServer->mTimeoutCheckInterval) == WAIT_TIMEOUT)
+	{
+		chatServer->checkTimeout();
+	}
+
+	return 0;
+}
+
+void ChatServer::checkTimeout(void)
+{
+	const uint64_t targetTick = (::GetTickCount64() - mTimeoutBaseTick) / mTimeoutCheckInterval;
+
+	mPlayerMapLock.ReadLock();
+	mTimeoutWheelLock.Lock();
+	{
+		mTimeoutWheel.Advance(targetTick, [this](TimingWheel::Node* node)
+		{
+			Player* player = static_cast<Player*>(node->Owner);
+
+			const uint32_t timeout = player->IsLoggedIn() ? mTimeoutLoggedIn : mTimeoutNotLoggedIn;
+			int32_t elapsed = static_cast<int32_t>(::timeGetTime() - player->GetLastRecvTick());
+
+			if (elapsed < 0)
+			{
+				elapsed = 0;
+			}
+
+			if (static_cast<uint32_t>(elapsed) >= timeout)
+			{
+				mTimeoutSessions.push_back(player->GetSessionID());
+				return;
+			}
+
+			// received something since it was armed: re-arm from the last receive time
+			mTimeoutWheel.Schedule(node, mTimeoutWheel.GetCurrentTick() + toTimeoutTicks(timeout - elapsed));
+		});
+	}
+	mTimeoutWheelLock.Unlock();
+	mPlayerMapLock.ReadUnlock();
+
+	for (uint64_t sessionID : mTimeoutSessions)
+	{
+		LOGF(ELogLevel::Debug, L"Timeout disconnect (sessionID = %llu)", sessionID);
+		Disconnect(sessionID);
+	}
+
+	mTimeoutSessions.clear();
+}
+
 void ChatServer::OnAccept(const uint64_t sessionID)
 {
 	mPlayerMapLock.Lock();
@@ -23,6 +105,17 @@ void ChatServer::OnAccept(const uint64_t sessionID)
 		newPlayer->Init(sessionID);
 
 		mPlayerMap.insert(std::make_pair(sessionID, newPlayer));
+
+		// arm with the shorter timeout; it is re-armed from the actual state when it fires
+		const uint32_t timeout = (mTimeoutLoggedIn < mTimeoutNotLoggedIn) ? mTimeoutLoggedIn : mTimeoutNotLoggedIn;
+
+		mTimeoutWheelLock.Lock();
+		{
+			TimingWheel::Node* timeoutNode = newPlayer->GetTimeoutNode();
+			timeoutNode->Owner = newPlayer;
+			mTimeoutWheel.Schedule(timeoutNode, mTimeoutWheel.GetCurrentTick() + toTimeoutTicks(timeout));
+		}
+		mTimeoutWheelLock.Unlock();
 	}
 	mPlayerMapLock.Unlock();
 }
@@ -48,6 +141,12 @@ void ChatServer::OnRelease(const uint64_t sessionID)
 			mSectorLock[sectorY][sectorX].Unlock();
 		}
 
+		mTimeoutWheelLock.Lock();
+		{
+			mTimeoutWheel.Cancel(deletePlayer->GetTimeoutNode());
+		}
+		mTimeoutWheelLock.Unlock();
+
 		mPlayerMap.erase(found);
 
 		mPlayerPool.Free(deletePlayer);
@@ -56,9 +155,65 @@ void ChatServer::OnRelease(const uint64_t sessionID)
 }
 
 void ChatServer::OnReceive(const uint64_t sessionID, Serializer* packet)
+{
+	OnReceiveBatch(sessionID, &packet, 1);
+}
+
+void ChatServer::OnReceiveBatch(const uint64_t sessionID, Serializer* const packets[], const uint32_t packetCount)
+{
+	bool bMalformed = false;
+
+	// one player lookup and one player lock for the whole batch
+	mPlayerMapLock.ReadLock();
+	{
+		Player* player = findPlayerOrNull(sessionID);
+		if (player != nullptr)
+		{
+			player->UpdateLastRecvTick();
+
+			player->Lock();
+			{
+				for (uint32_t i = 0; i < packetCount; ++i)
+				{
+					if (!handlePacket(player, packets[i]))
+					{
+						bMalformed = true;
+						break;
+					}
+				}
+			}
+			player->Unlock();
+		}
+	}
+	mPlayerMapLock.ReadUnlock();
+
+	flushPendingSends();
+
+	if (bMalformed)
+	{
+		Disconnect(sessionID);
+	}
+
+	for (uint32_t i = 0; i < packetCount; ++i)
+	{
+		packets[i]->DecrementRefCount();
+	}
+}
+
+bool ChatServer::handlePacket(Player* player, Serializer* packet)
 {
 	WORD messageType;
 
+	if (packet->GetUseSize() < sizeof(messageType))
+	{
+		return false;
+	}
+
+	LARGE_INTEGER beginCounter;
+	::QueryPerformanceCounter(&beginCounter);
+
+	const size_t fanOutBegin = l_pendingSends.Targets.size();
+
 	*packet >> messageType;
 
 	switch (messageType)
@@ -69,12 +224,13 @@ void ChatServer::OnReceive(const uint64_t sessionID, Serializer* packet)
 		WCHAR id[20]{};
 		WCHAR nickName[20]{};
 		char sessionKey[64]{};
+		BYTE features = 0;
 
+		// Features is optional (older clients send the packet without it)
 		constexpr uint32_t PACKET_SIZE = sizeof(messageType) + sizeof(accountNo) + sizeof(id) + sizeof(nickName) + sizeof(sessionKey);
-		if (packet->GetUseSize() != PACKET_SIZE)
+		if (packet->GetUseSize() != PACKET_SIZE && packet->GetUseSize() != PACKET_SIZE + sizeof(features))
 		{
-			Disconnect(sessionID);
-			break;
+			return false;
 		}
 
 		*packet >> accountNo;
@@ -82,7 +238,12 @@ void ChatServer::OnReceive(const uint64_t sessionID, Serializer* packet)
 		packet->GetByte((char*)nickName, sizeof(nickName));
 		packet->GetByte((char*)sessionKey, sizeof(sessionKey));
 
-		Process_CS_CHAT_REQ_LOGIN(sessionID, accountNo, id, nickName, sessionKey);
+		if (packet->GetUseSize() == PACKET_SIZE + sizeof(features))
+		{
+			*packet >> features;
+		}
+
+		Process_CS_CHAT_REQ_LOGIN(player, accountNo, id, nickName, sessionKey, features);
 	}
 	break;
 	case en_PACKET_TYPE::en_PACKET_CS_CHAT_REQ_SECTOR_MOVE:
@@ -94,39 +255,36 @@ void ChatServer::OnReceive(const uint64_t sessionID, Serializer* packet)
 		constexpr uint32_t PACKET_SIZE = sizeof(messageType) + sizeof(accountNo) + sizeof(sectorX) + sizeof(sectorY);
 		if (packet->GetUseSize() != PACKET_SIZE)
 		{
-			Disconnect(sessionID);
-			break;
+			return false;
 		}
 
 		*packet >> accountNo >> sectorX >> sectorY;
 
-		Process_CS_CHAT_REQ_SECTOR_MOVE(sessionID, accountNo, sectorX, sectorY);
+		Process_CS_CHAT_REQ_SECTOR_MOVE(player, accountNo, sectorX, sectorY);
 	}
 	break;
 	case en_PACKET_TYPE::en_PACKET_CS_CHAT_REQ_MESSAGE:
 	{
 		int64_t accountNo;
 		WORD messageLen;
-		thread_local WCHAR message[UINT16_MAX / 2];
 
 		constexpr uint32_t PACKET_MIN_SIZE = sizeof(messageType) + sizeof(accountNo) + sizeof(messageLen);
 		if (packet->GetUseSize() < PACKET_MIN_SIZE)
 		{
-			Disconnect(sessionID);
-			break;
+			return false;
 		}
 
 		*packet >> accountNo >> messageLen;
 
 		if (packet->GetUseSize() != PACKET_MIN_SIZE + messageLen)
 		{
-			Disconnect(sessionID);
-			break;
+			return false;
 		}
 
-		packet->GetByte((char*)message, messageLen);
+		// no copy: message points into the packet buffer (valid until packet release, or only until OnReceive returns for zero-copy views)
+		const WCHAR* message = reinterpret_cast<const WCHAR*>(packet->GetBytePointer(messageLen));
 
-		Process_CS_CHAT_REQ_MESSAGE(sessionID, accountNo, messageLen, message);
+		Process_CS_CHAT_REQ_MESSAGE(player, accountNo, messageLen, message);
 	}
 	break;
 	case en_PACKET_TYPE::en_PACKET_CS_CHAT_REQ_HEARTBEAT:
@@ -134,328 +292,341 @@ void ChatServer::OnReceive(const uint64_t sessionID, Serializer* packet)
 		constexpr uint32_t PACKET_SIZE = sizeof(messageType);
 		if (packet->GetUseSize() != PACKET_SIZE)
 		{
-			Disconnect(sessionID);
-			break;
+			return false;
 		}
 
-		Process_CS_CHAT_REQ_HEARTBEAT(sessionID);
+		// last recv tick is already updated once per batch
 	}
 	break;
 	default:
-		Disconnect(sessionID);
+		return false;
 	}
 
-	packet->DecrementRefCount();
+	static const LARGE_INTEGER frequency = []() { LARGE_INTEGER f; ::QueryPerformanceFrequency(&f); return f; }();
+
+	LARGE_INTEGER endCounter;
+	::QueryPerformanceCounter(&endCounter);
+
+	const uint64_t elapsedNanoseconds = static_cast<uint64_t>(endCounter.QuadPart - beginCounter.QuadPart) * 1'000'000'000 / frequency.QuadPart;
+
+	recordPacketTypeStats(messageType, elapsedNanoseconds, l_pendingSends.Targets.size() - fanOutBegin);
+
+	return true;
 }
 
-void ChatServer::Process_CS_CHAT_REQ_LOGIN(const uint64_t sessionID, const int64_t accountNo, const WCHAR id[], const WCHAR nickName[], const char sessionKey[])
+void ChatServer::recordPacketTypeStats(const WORD messageType, const uint64_t handlerNanoseconds, const uint64_t fanOut)
 {
-	mPlayerMapLock.ReadLock();
+	if (l_packetTypeHistograms == nullptr)
 	{
-		Player* player = findPlayerOrNull(sessionID);
-		if (player == nullptr)
+		const uint32_t index = InterlockedIncrement(&mPacketTypeHistogramCount) - 1;
+		ASSERT_LIVE(index < MAX_STATS_THREAD_COUNT, L"too many threads for packet type stats");
+
+		l_packetTypeHistograms = new PacketTypeHistograms;
+		mPacketTypeHistograms[index] = l_packetTypeHistograms;
+	}
+
+	l_packetTypeHistograms->HandlerNanoseconds[messageType].Record(handlerNanoseconds);
+	l_packetTypeHistograms->FanOut[messageType].Record(fanOut);
+}
+
+void ChatServer::CollectPacketTypeStats(PacketTypeStats outStats[PACKET_TYPE_COUNT])
+{
+	// heap: the merged set is too large for the stack
+	PacketTypeHistograms* total = new PacketTypeHistograms;
+
+	const uint32_t threadCount = *static_cast<volatile uint32_t*>(&mPacketTypeHistogramCount);
+
+	for (uint32_t i = 0; i < threadCount && i < MAX_STATS_THREAD_COUNT; ++i)
+	{
+		// registered after the count was bumped: picked up on the next collect
+		const PacketTypeHistograms* histograms = *static_cast<PacketTypeHistograms* volatile*>(&mPacketTypeHistograms[i]);
+		if (histograms == nullptr)
 		{
-			mPlayerMapLock.Unlock();
-			return;
+			continue;
 		}
 
-		player->UpdateLastRecvTick();
-
-		player->Lock();
+		for (uint32_t type = 0; type < PACKET_TYPE_COUNT; ++type)
 		{
-			player->LogIn(accountNo, id, nickName, sessionKey);
+			total->HandlerNanoseconds[type].Merge(histograms->HandlerNanoseconds[type]);
+			total->FanOut[type].Merge(histograms->FanOut[type]);
 		}
-		player->Unlock();
 	}
-	mPlayerMapLock.ReadUnlock();
 
-	Serializer* packet = CreateMessage_CS_CHAT_RES_LOGIN(1, accountNo);
+	for (uint32_t type = 0; type < PACKET_TYPE_COUNT; ++type)
+	{
+		LogLinearHistogram handlerNanoseconds = total->HandlerNanoseconds[type];
+		LogLinearHistogram fanOut = total->FanOut[type];
+
+		handlerNanoseconds.Subtract(mLastPacketTypeHistograms.HandlerNanoseconds[type]);
+		fanOut.Subtract(mLastPacketTypeHistograms.FanOut[type]);
+
+		outStats[type].Count = handlerNanoseconds.GetCount();
+		outStats[type].HandlerNanosecondsP50 = handlerNanoseconds.GetPercentile(50.0);
+		outStats[type].HandlerNanosecondsP99 = handlerNanoseconds.GetPercentile(99.0);
+		outStats[type].HandlerNanosecondsP999 = handlerNanoseconds.GetPercentile(99.9);
+		outStats[type].FanOutP50 = fanOut.GetPercentile(50.0);
+		outStats[type].FanOutP99 = fanOut.GetPercentile(99.0);
+		outStats[type].FanOutP999 = fanOut.GetPercentile(99.9);
+	}
 
-	SendPacket(sessionID, packet);
+	mLastPacketTypeHistograms = *total;
 
-	packet->DecrementRefCount();
+	delete total;
 }
 
-void ChatServer::Process_CS_CHAT_REQ_SECTOR_MOVE(const uint64_t sessionID, const int64_t accountNo, const WORD sectorX, const WORD sectorY)
+void ChatServer::queueSend(Serializer* packet, const uint64_t sessionID)
+{
+	const uint32_t targetBegin = static_cast<uint32_t>(l_pendingSends.Targets.size());
+
+	l_pendingSends.Targets.push_back(sessionID);
+	l_pendingSends.Packets.push_back({ packet, targetBegin, targetBegin + 1 });
+}
+
+void ChatServer::flushPendingSends(void)
+{
+	for (const PendingSend& pendingSend : l_pendingSends.Packets)
+	{
+		SendPacketMulti(l_pendingSends.Targets.data() + pendingSend.TargetBegin, pendingSend.TargetEnd - pendingSend.TargetBegin, pendingSend.Packet);
+
+		pendingSend.Packet->DecrementRefCount();
+	}
+
+	l_pendingSends.Packets.clear();
+	l_pendingSends.Targets.clear();
+}
+
+void ChatServer::Process_CS_CHAT_REQ_LOGIN(Player* player, const int64_t accountNo, const WCHAR id[], const WCHAR nickName[], const char sessionKey[], const BYTE features)
+{
+	player->LogIn(accountNo, id, nickName, sessionKey);
+
+	// applies from the next send, so the login response already goes out framed
+	if (features & en_LOGIN_FEATURE_MULTI_MESSAGE_FRAME)
+	{
+		SetSessionMultiMessageFrame(player->GetSessionID());
+	}
+
+	if (features & en_LOGIN_FEATURE_COMPRESSION)
+	{
+		SetSessionCompression(player->GetSessionID());
+	}
+
+	queueSend(CreateMessage_CS_CHAT_RES_LOGIN(1, accountNo), player->GetSessionID());
+}
+
+void ChatServer::Process_CS_CHAT_REQ_SECTOR_MOVE(Player* player, const int64_t accountNo, const WORD sectorX, const WORD sectorY)
 {
 	ASSERT_LIVE(sectorX >= 0 && sectorX < 50, L"CS_CHAT_REQ_SECTOR_MOVE invalid sectorX received");
 	ASSERT_LIVE(sectorY >= 0 && sectorY < 50, L"CS_CHAT_REQ_SECTOR_MOVE invalid sectorY received");
 
-	int64_t playerAccountNo;
+	uint16_t playerPrevSectorX = player->GetSectorX();
+	uint16_t playerPrevSectorY = player->GetSectorY();
 
-	mPlayerMapLock.ReadLock();
+	if (player->IsSectorIn())
 	{
-		Player* player = findPlayerOrNull(sessionID);
-		if (player == nullptr)
+		if (sectorY == playerPrevSectorY && sectorX == playerPrevSectorX)
 		{
-			mPlayerMapLock.Unlock();
-			return;
+			// do nothing
 		}
-
-		player->UpdateLastRecvTick();
-
-		player->Lock();
+		else if (sectorY > playerPrevSectorY || (sectorY == playerPrevSectorY && sectorX > playerPrevSectorX))
 		{
-			uint16_t playerPrevSectorX = player->GetSectorX();
-			uint16_t playerPrevSectorY = player->GetSectorY();
-
-			playerAccountNo = player->GetAccountNo();
-
-			if (player->IsSectorIn())
+			mSectorLock[playerPrevSectorY][playerPrevSectorX].Lock();
+			mSectorLock[sectorY][sectorX].Lock();
 			{
-				if (sectorY == playerPrevSectorY && sectorX == playerPrevSectorX)
-				{
-					// do nothing
-				}
-				else if (sectorY > playerPrevSectorY || (sectorY == playerPrevSectorY && sectorX > playerPrevSectorX))
-				{
-					mSectorLock[playerPrevSectorY][playerPrevSectorX].Lock();
-					mSectorLock[sectorY][sectorX].Lock();
-					{
-						mSector[playerPrevSectorY][playerPrevSectorX].erase(player->GetSessionID());
-						mSector[sectorY][sectorX].insert(player->GetSessionID());
-					}
-					mSectorLock[sectorY][sectorX].Unlock();
-					mSectorLock[playerPrevSectorY][playerPrevSectorX].Unlock();
-				}
-				else
-				{
-					mSectorLock[sectorY][sectorX].Lock();
-					mSectorLock[playerPrevSectorY][playerPrevSectorX].Lock();
-					{
-						mSector[playerPrevSectorY][playerPrevSectorX].erase(player->GetSessionID());
-						mSector[sectorY][sectorX].insert(player->GetSessionID());
-					}
-					mSectorLock[playerPrevSectorY][playerPrevSectorX].Unlock();
-					mSectorLock[sectorY][sectorX].Unlock();
-				}
+				mSector[playerPrevSectorY][playerPrevSectorX].erase(player->GetSessionID());
+				mSector[sectorY][sectorX].insert(player->GetSessionID());
 			}
-			else
+			mSectorLock[sectorY][sectorX].Unlock();
+			mSectorLock[playerPrevSectorY][playerPrevSectorX].Unlock();
+		}
+		else
+		{
+			mSectorLock[sectorY][sectorX].Lock();
+			mSectorLock[playerPrevSectorY][playerPrevSectorX].Lock();
 			{
-				mSectorLock[sectorY][sectorX].Lock();
-				{
-					mSector[sectorY][sectorX].insert(player->GetSessionID());
-				}
-				mSectorLock[sectorY][sectorX].Unlock();
+				mSector[playerPrevSectorY][playerPrevSectorX].erase(player->GetSessionID());
+				mSector[sectorY][sectorX].insert(player->GetSessionID());
 			}
-
-			player->MoveSector(sectorX, sectorY);
+			mSectorLock[playerPrevSectorY][playerPrevSectorX].Unlock();
+			mSectorLock[sectorY][sectorX].Unlock();
 		}
-		player->Unlock();
 	}
-	mPlayerMapLock.ReadUnlock();
-
-	Serializer* packet = CreateMessage_CS_CHAT_RES_SECTOR_MOVE(playerAccountNo, sectorX, sectorY);
+	else
+	{
+		mSectorLock[sectorY][sectorX].Lock();
+		{
+			mSector[sectorY][sectorX].insert(player->GetSessionID());
+		}
+		mSectorLock[sectorY][sectorX].Unlock();
+	}
 
-	SendPacket(sessionID, packet);
+	player->MoveSector(sectorX, sectorY);
 
-	packet->DecrementRefCount();
+	queueSend(CreateMessage_CS_CHAT_RES_SECTOR_MOVE(player->GetAccountNo(), sectorX, sectorY), player->GetSessionID());
 }
 
-void ChatServer::Process_CS_CHAT_REQ_MESSAGE(const uint64_t sessionID, const int64_t accountNo, const WORD messageLen, const WCHAR message[])
+void ChatServer::Process_CS_CHAT_REQ_MESSAGE(Player* player, const int64_t accountNo, const WORD messageLen, const WCHAR message[])
 {
-	Serializer* packet;
+	ASSERT_LIVE(player->IsSectorIn(), L"CS_CHAT_REQ_MESSAGE player is not in any sector");
 
-	std::vector<uint64_t> sendOtherSessions;
+	Serializer* packet = CreateMessage_CS_CHAT_RES_MESSAGE(player->GetAccountNo(), player->GetID(), player->GetNickName(), messageLen, message);
 
-	mPlayerMapLock.ReadLock();
+	// Lock
+	if (player->GetSectorY() > 0)
 	{
-		Player* player = findPlayerOrNull(sessionID);
-		if (player == nullptr)
+		if (player->GetSectorX() > 0)
 		{
-			mPlayerMapLock.Unlock();
-			return;
+			mSectorLock[player->GetSectorY() - 1][player->GetSectorX() - 1].ReadLock();
 		}
-
-		player->UpdateLastRecvTick();
-
-		player->Lock();
 		{
-			ASSERT_LIVE(player->GetSessionID() == sessionID, L"CS_CHAT_REQ_MESSAGE player->GetSessionID() != sessionID");
-			ASSERT_LIVE(player->IsSectorIn(), L"CS_CHAT_REQ_MESSAGE player is not in any sector");
+			mSectorLock[player->GetSectorY() - 1][player->GetSectorX()].ReadLock();
+		}
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			mSectorLock[player->GetSectorY() - 1][player->GetSectorX() + 1].ReadLock();
+		}
+	}
+	{
+		if (player->GetSectorX() > 0)
+		{
+			mSectorLock[player->GetSectorY()][player->GetSectorX() - 1].ReadLock();
+		}
+		{
+			mSectorLock[player->GetSectorY()][player->GetSectorX()].ReadLock();
+		}
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			mSectorLock[player->GetSectorY()][player->GetSectorX() + 1].ReadLock();
+		}
+	}
+	if (player->GetSectorY() < SECTOR_WIDTH_AND_HEIGHT - 1)
+	{
+		if (player->GetSectorX() > 0)
+		{
+			mSectorLock[player->GetSectorY() + 1][player->GetSectorX() - 1].ReadLock();
+		}
+		{
+			mSectorLock[player->GetSectorY() + 1][player->GetSectorX()].ReadLock();
+		}
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			mSectorLock[player->GetSectorY() + 1][player->GetSectorX() + 1].ReadLock();
+		}
+	}
 
-			packet = CreateMessage_CS_CHAT_RES_MESSAGE(player->GetAccountNo(), player->GetID(), player->GetNickName(), messageLen, message);
+	// get session IDs (appended to the pending send targets)
+	const uint32_t targetBegin = static_cast<uint32_t>(l_pendingSends.Targets.size());
 
-			// Lock
-			if (player->GetSectorY() > 0)
+	if (player->GetSectorY() > 0)
+	{
+		if (player->GetSectorX() > 0)
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY() - 1][player->GetSectorX() - 1])
 			{
-				if (player->GetSectorX() > 0)
-				{
-					mSectorLock[player->GetSectorY() - 1][player->GetSectorX() - 1].ReadLock();
-				}
-				{
-					mSectorLock[player->GetSectorY() - 1][player->GetSectorX()].ReadLock();
-				}
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					mSectorLock[player->GetSectorY() - 1][player->GetSectorX() + 1].ReadLock();
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
+		}
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY() - 1][player->GetSectorX()])
 			{
-				if (player->GetSectorX() > 0)
-				{
-					mSectorLock[player->GetSectorY()][player->GetSectorX() - 1].ReadLock();
-				}
-				{
-					mSectorLock[player->GetSectorY()][player->GetSectorX()].ReadLock();
-				}
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					mSectorLock[player->GetSectorY()][player->GetSectorX() + 1].ReadLock();
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
-			if (player->GetSectorY() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		}
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY() - 1][player->GetSectorX() + 1])
 			{
-				if (player->GetSectorX() > 0)
-				{
-					mSectorLock[player->GetSectorY() + 1][player->GetSectorX() - 1].ReadLock();
-				}
-				{
-					mSectorLock[player->GetSectorY() + 1][player->GetSectorX()].ReadLock();
-				}
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					mSectorLock[player->GetSectorY() + 1][player->GetSectorX() + 1].ReadLock();
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
-
-			// get session IDs
-			if (player->GetSectorY() > 0)
+		}
+	}
+	{
+		if (player->GetSectorX() > 0)
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY()][player->GetSectorX() - 1])
 			{
-				if (player->GetSectorX() > 0)
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY() - 1][player->GetSectorX() - 1])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY() - 1][player->GetSectorX()])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY() - 1][player->GetSectorX() + 1])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
+		}
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY()][player->GetSectorX()])
 			{
-				if (player->GetSectorX() > 0)
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY()][player->GetSectorX() - 1])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY()][player->GetSectorX()])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY()][player->GetSectorX() + 1])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
-			if (player->GetSectorY() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		}
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY()][player->GetSectorX() + 1])
 			{
-				if (player->GetSectorX() > 0)
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY() + 1][player->GetSectorX() - 1])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY() + 1][player->GetSectorX()])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					for (const uint64_t otherSession : mSector[player->GetSectorY() + 1][player->GetSectorX() + 1])
-					{
-						sendOtherSessions.push_back(otherSession);
-					}
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
-
-			// unlock
-			if (player->GetSectorY() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		}
+	}
+	if (player->GetSectorY() < SECTOR_WIDTH_AND_HEIGHT - 1)
+	{
+		if (player->GetSectorX() > 0)
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY() + 1][player->GetSectorX() - 1])
 			{
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					mSectorLock[player->GetSectorY() + 1][player->GetSectorX() + 1].ReadUnlock();
-				}
-				{
-					mSectorLock[player->GetSectorY() + 1][player->GetSectorX()].ReadUnlock();
-				}
-				if (player->GetSectorX() > 0)
-				{
-					mSectorLock[player->GetSectorY() + 1][player->GetSectorX() - 1].ReadUnlock();
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
+		}
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY() + 1][player->GetSectorX()])
 			{
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					mSectorLock[player->GetSectorY()][player->GetSectorX() + 1].ReadUnlock();
-				}
-				{
-					mSectorLock[player->GetSectorY()][player->GetSectorX()].ReadUnlock();
-				}
-				if (player->GetSectorX() > 0)
-				{
-					mSectorLock[player->GetSectorY()][player->GetSectorX() - 1].ReadUnlock();
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
-			if (player->GetSectorY() > 0)
+		}
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			for (const uint64_t otherSession : mSector[player->GetSectorY() + 1][player->GetSectorX() + 1])
 			{
-				if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
-				{
-					mSectorLock[player->GetSectorY() - 1][player->GetSectorX() + 1].ReadUnlock();
-				}
-				{
-					mSectorLock[player->GetSectorY() - 1][player->GetSectorX()].ReadUnlock();
-				}
-				if (player->GetSectorX() > 0)
-				{
-					mSectorLock[player->GetSectorY() - 1][player->GetSectorX() - 1].ReadUnlock();
-				}
+				l_pendingSends.Targets.push_back(otherSession);
 			}
 		}
-		player->Unlock();
 	}
-	mPlayerMapLock.ReadUnlock();
 
-	for (const uint64_t otherSession : sendOtherSessions)
+	// unlock
+	if (player->GetSectorY() < SECTOR_WIDTH_AND_HEIGHT - 1)
 	{
-		SendPacket(otherSession, packet);
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			mSectorLock[player->GetSectorY() + 1][player->GetSectorX() + 1].ReadUnlock();
+		}
+		{
+			mSectorLock[player->GetSectorY() + 1][player->GetSectorX()].ReadUnlock();
+		}
+		if (player->GetSectorX() > 0)
+		{
+			mSectorLock[player->GetSectorY() + 1][player->GetSectorX() - 1].ReadUnlock();
+		}
 	}
-
-	packet->DecrementRefCount();
-}
-
-void ChatServer::Process_CS_CHAT_REQ_HEARTBEAT(const uint64_t sessionID)
-{
-	mPlayerMapLock.ReadLock();
 	{
-		Player* player = findPlayerOrNull(sessionID);
-		if (player == nullptr)
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
 		{
-			mPlayerMapLock.Unlock();
-			return;
+			mSectorLock[player->GetSectorY()][player->GetSectorX() + 1].ReadUnlock();
+		}
+		{
+			mSectorLock[player->GetSectorY()][player->GetSectorX()].ReadUnlock();
+		}
+		if (player->GetSectorX() > 0)
+		{
+			mSectorLock[player->GetSectorY()][player->GetSectorX() - 1].ReadUnlock();
 		}
-
-		player->UpdateLastRecvTick();
 	}
-	mPlayerMapLock.ReadUnlock();
-}
\ No newline at end of file
+	if (player->GetSectorY() > 0)
+	{
+		if (player->GetSectorX() < SECTOR_WIDTH_AND_HEIGHT - 1)
+		{
+			mSectorLock[player->GetSectorY() - 1][player->GetSectorX() + 1].ReadUnlock();
+		}
+		{
+			mSectorLock[player->GetSectorY() - 1][player->GetSectorX()].ReadUnlock();
+		}
+		if (player->GetSectorX() > 0)
+		{
+			mSectorLock[player->GetSectorY() - 1][player->GetSectorX() - 1].ReadUnlock();
+		}
+	}
+
+	l_pendingSends.Packets.push_back({ packet, targetBegin, static_cast<uint32_t>(l_pendingSends.Targets.size()) });
+}
@@ -7,10 +7,12 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include "Lock.h"
 #include "Player.h"
 #include "NetLibrary/Memory/ObjectPool.h"
+#include "NetLibrary/Tool/LogLinearHistogram.h"
 
 class ChatServer : public NetServer
 {
@@ -19,23 +21,56 @@ public:
 	virtual void OnAccept(const uint64_t sessionID) override;
 	virtual void OnRelease(const uint64_t sessionID) override;
 	virtual void OnReceive(const uint64_t sessionID, Serializer* packet) override;
+	virtual void OnReceiveBatch(const uint64_t sessionID, Serializer* const packets[], const uint32_t packetCount) override;
 
 public:
 
 	ChatServer() = default;
 	virtual ~ChatServer() override { if (IsRunning()) Shutdown(); }
 
+	virtual void Start(const uint16_t port, const uint32_t maxSessionCount, const uint32_t iocpConcurrentThreadCount, const uint32_t iocpWorkerThreadCount) override;
+	virtual void Shutdown(void) override;
+
+	// idle timeouts in milliseconds (call before Start)
+	inline void SetTimeout(const uint32_t checkInterval, const uint32_t loggedIn, const uint32_t notLoggedIn)
+	{
+		mTimeoutCheckInterval = checkInterval;
+		mTimeoutLoggedIn = loggedIn;
+		mTimeoutNotLoggedIn = notLoggedIn;
+	}
+
 public:
 
 	inline uint32_t GetPlayerPoolSize(void) const { return mPlayerPool.GetTotalCreatedObjectCount(); }
 	inline size_t GetPlayerCount(void) const { return mPlayerMap.size(); }
 
+	enum
+	{
+		PACKET_TYPE_COUNT = en_PACKET_CS_CHAT_REQ_HEARTBEAT + 1,
+		MAX_STATS_THREAD_COUNT = 256
+	};
+
+	// handler stats of one packet type over one collect interval
+	struct PacketTypeStats
+	{
+		uint64_t Count;
+		uint64_t HandlerNanosecondsP50;
+		uint64_t HandlerNanosecondsP99;
+		uint64_t HandlerNanosecondsP999;
+		uint64_t FanOutP50;
+		uint64_t FanOutP99;
+		uint64_t FanOutP999;
+	};
+
+	// merge the per-thread histograms and return what was recorded since the previous call (call from one thread only)
+	void CollectPacketTypeStats(PacketTypeStats outStats[PACKET_TYPE_COUNT]);
+
 public:
 
-	void Process_CS_CHAT_REQ_LOGIN(const uint64_t sessionID, const int64_t accountNo, const WCHAR id[], const WCHAR nickName[], const char sessionKey[]);
-	void Process_CS_CHAT_REQ_SECTOR_MOVE(const uint64_t sessionID, const int64_t accountNo, const WORD sectorX, const WORD sectorY);
-	void Process_CS_CHAT_REQ_MESSAGE(const uint64_t sessionID, const int64_t accountNo, const WORD messageLen, const WCHAR message[]);
-	void Process_CS_CHAT_REQ_HEARTBEAT(const uint64_t sessionID);
+	// caller holds mPlayerMapLock (read) and the player lock; responses are queued and sent after the locks are released
+	void Process_CS_CHAT_REQ_LOGIN(Player* player, const int64_t accountNo, const WCHAR id[], const WCHAR nickName[], const char sessionKey[], const BYTE features);
+	void Process_CS_CHAT_REQ_SECTOR_MOVE(Player* player, const int64_t accountNo, const WORD sectorX, const WORD sectorY);
+	void Process_CS_CHAT_REQ_MESSAGE(Player* player, const int64_t accountNo, const WORD messageLen, const WCHAR message[]);
 
 	static Serializer* CreateMessage_CS_CHAT_RES_LOGIN(const BYTE Status, const int64_t AccountNo)
 	{
@@ -66,6 +101,9 @@ public:
 		*packet << messageLen;
 		packet->InsertByte((const char*)message, messageLen);
 
+		// a slow consumer may miss chat lines, but never login/sector responses
+		packet->SetDroppable();
+
 		return packet;
 	}
 
@@ -73,6 +111,44 @@ private:
 
 	Player* findPlayerOrNull(const uint64_t sessionID);
 
+	// parse one packet and run its handler, false if the packet is malformed
+	bool handlePacket(Player* player, Serializer* packet);
+
+	// per packet type handler time (ns) and fan-out (queued send targets), one set per worker thread
+	struct PacketTypeHistograms
+	{
+		LogLinearHistogram HandlerNanoseconds[PACKET_TYPE_COUNT];
+		LogLinearHistogram FanOut[PACKET_TYPE_COUNT];
+	};
+
+	inline static thread_local PacketTypeHistograms* l_packetTypeHistograms = nullptr;
+
+	void recordPacketTypeStats(const WORD messageType, const uint64_t handlerNanoseconds, const uint64_t fanOut);
+
+	// responses built while content locks are held (per worker thread, flushed at the end of OnReceiveBatch)
+	struct PendingSend
+	{
+		Serializer* Packet;
+		uint32_t TargetBegin;	// [TargetBegin, TargetEnd) of PendingSendList::Targets
+		uint32_t TargetEnd;
+	};
+
+	struct PendingSendList
+	{
+		std::vector<PendingSend> Packets;
+		std::vector<uint64_t> Targets;
+	};
+
+	inline static thread_local PendingSendList l_pendingSends;
+
+	void queueSend(Serializer* packet, const uint64_t sessionID);
+	void flushPendingSends(void);
+
+	// timeout wheel (one tick = mTimeoutCheckInterval ms)
+	static unsigned int timeoutThread(void* chatServerParam);
+	void checkTimeout(void);
+	inline uint64_t toTimeoutTicks(const uint32_t milliseconds) const { return (milliseconds + mTimeoutCheckInterval - 1) / mTimeoutCheckInterval; }
+
 private:
 	enum
 	{
@@ -87,4 +163,18 @@ private:
 	std::set<uint64_t> mSector[SECTOR_WIDTH_AND_HEIGHT][SECTOR_WIDTH_AND_HEIGHT];
 	SrwLock mPlayerMapLock;
 	SrwLock mSectorLock[SECTOR_WIDTH_AND_HEIGHT][SECTOR_WIDTH_AND_HEIGHT];
+
+	uint32_t mTimeoutCheckInterval = TIMEOUT_CHECK_INTERVAL;
+	uint32_t mTimeoutLoggedIn = TIMEOUT_LOGGED_IN;
+	uint32_t mTimeoutNotLoggedIn = TIMEOUT_NOT_LOGGED_IN;
+	TimingWheel mTimeoutWheel;
+	SrwLock mTimeoutWheelLock;			// lock order: mPlayerMapLock -> mTimeoutWheelLock
+	uint64_t mTimeoutBaseTick;			// GetTickCount64() at wheel tick 0
+	HANDLE mTimeoutThread = nullptr;
+	HANDLE mTimeoutThreadExitEvent = nullptr;
+	std::vector<uint64_t> mTimeoutSessions;	// used only by the timeout thread
+
+	PacketTypeHistograms* mPacketTypeHistograms[MAX_STATS_THREAD_COUNT] = {};	// registered by each worker on its first packet
+	uint32_t mPacketTypeHistogramCount = 0;
+	PacketTypeHistograms mLastPacketTypeHistograms;	// merged totals at the previous collect
 };
\ No newline at end of file
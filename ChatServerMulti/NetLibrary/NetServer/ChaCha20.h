@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <emmintrin.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// ChaCha20 Ʈ ȣ (20 ,   64Ʈ  ī + 64Ʈ nonce)
+// Ű Ʈ (Ű, nonce,  ȣ)  Ϳ ϹǷ       ִ
+// SSE2 4(AVX2  8)  XORϰ,  ߰   Ű Ʈ ߴٰ  ȣ⿡ ̾ 
+// ȭ  Ƿ Ʈ ϳ    常  
+class ChaCha20
+{
+public:
+    enum : uint32_t
+    {
+        KEY_SIZE = 32,
+        BLOCK_SIZE = 64
+    };
+
+    // Ű nonce ϰ Ʈ ó( 0) ư
+    inline void Init(const uint8_t key[KEY_SIZE], const uint64_t nonce)
+    {
+        memcpy(mKey, key, KEY_SIZE);
+        mNonce = nonce;
+        mCounter = 0;
+        mKeyStreamOffset = BLOCK_SIZE;
+    }
+
+    // data Ű Ʈ XOR (ȣȭ, ȣȭ ), Ʈ ġ sizeŭ Ѵ
+    void Process(char* data, uint32_t size);
+
+    // counter°  Ű Ʈ 64Ʈ (Ű  )
+    static void Block(const uint8_t key[KEY_SIZE], const uint64_t counter, const uint64_t nonce, uint8_t out[BLOCK_SIZE]);
+
+private:
+    static inline void makeState(const uint32_t key[8], const uint64_t counter, const uint64_t nonce, uint32_t outState[16])
+    {
+        // "expand 32-byte k"
+        outState[0] = 0x6170'7865;
+        outState[1] = 0x3320'646e;
+        outState[2] = 0x7962'2d32;
+        outState[3] = 0x6b20'6574;
+        memcpy(outState + 4, key, KEY_SIZE);
+        outState[12] = static_cast<uint32_t>(counter);
+        outState[13] = static_cast<uint32_t>(counter >> 32);
+        outState[14] = static_cast<uint32_t>(nonce);
+        outState[15] = static_cast<uint32_t>(nonce >> 32);
+    }
+
+    static void generateBlock(const uint32_t state[16], uint8_t out[BLOCK_SIZE]);
+
+    // state īͺ 4(8) з Ű Ʈ data XOR
+    static void xorBlocks4(char* data, const uint32_t state[16]);
+#ifdef __AVX2__
+    static void xorBlocks8(char* data, const uint32_t state[16]);
+#endif
+
+private:
+    uint32_t    mKey[8];
+    uint64_t    mNonce;
+    uint64_t    mCounter;                       //    ȣ
+    uint32_t    mKeyStreamOffset;               // mKeyStream    ġ (BLOCK_SIZE )
+    uint8_t     mKeyStream[BLOCK_SIZE];         //  ߰    Ű Ʈ
+};
+
+namespace ChaCha20Detail
+{
+    static inline uint32_t RotateLeft(const uint32_t value, const int bit)
+    {
+        return (value << bit) | (value >> (32 - bit));
+    }
+
+    static inline void QuarterRound(uint32_t x[16], const int a, const int b, const int c, const int d)
+    {
+        x[a] += x[b]; x[d] = RotateLeft(x[d] ^ x[a], 16);
+        x[c] += x[d]; x[b] = RotateLeft(x[b] ^ x[c], 12);
+        x[a] += x[b]; x[d] = RotateLeft(x[d] ^ x[a], 8);
+        x[c] += x[d]; x[b] = RotateLeft(x[b] ^ x[c], 7);
+    }
+
+    template <int BIT>
+    static inline __m128i RotateLeft(const __m128i value)
+    {
+        return _mm_or_si128(_mm_slli_epi32(value, BIT), _mm_srli_epi32(value, 32 - BIT));
+    }
+
+    // θ ٸ   
+    static inline void QuarterRound(__m128i& a, __m128i& b, __m128i& c, __m128i& d)
+    {
+        a = _mm_add_epi32(a, b); d = RotateLeft<16>(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d); b = RotateLeft<12>(_mm_xor_si128(b, c));
+        a = _mm_add_epi32(a, b); d = RotateLeft<8>(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d); b = RotateLeft<7>(_mm_xor_si128(b, c));
+    }
+
+#ifdef __AVX2__
+    template <int BIT>
+    static inline __m256i RotateLeft(const __m256i value)
+    {
+        return _mm256_or_si256(_mm256_slli_epi32(value, BIT), _mm256_srli_epi32(value, 32 - BIT));
+    }
+
+    static inline void QuarterRound(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+    {
+        a = _mm256_add_epi32(a, b); d = RotateLeft<16>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi32(c, d); b = RotateLeft<12>(_mm256_xor_si256(b, c));
+        a = _mm256_add_epi32(a, b); d = RotateLeft<8>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi32(c, d); b = RotateLeft<7>(_mm256_xor_si256(b, c));
+    }
+#endif
+
+    // ī  32Ʈ ġ  32Ʈ ø
+    static inline uint32_t CounterHigh(const uint32_t state[16], const uint32_t blockOffset)
+    {
+        return state[13] + ((state[12] + blockOffset < state[12]) ? 1 : 0);
+    }
+
+    static inline void XorBytes16(char* data, const __m128i keyStream)
+    {
+        __m128i* target = reinterpret_cast<__m128i*>(data);
+        _mm_storeu_si128(target, _mm_xor_si128(_mm_loadu_si128(target), keyStream));
+    }
+}
+
+inline void ChaCha20::Process(char* data, uint32_t size)
+{
+    //  ȣ⿡  Ű Ʈ 
+    while (size > 0 && mKeyStreamOffset < BLOCK_SIZE)
+    {
+        *data++ ^= mKeyStream[mKeyStreamOffset++];
+        size--;
+    }
+
+    uint32_t state[16];
+    makeState(mKey, mCounter, mNonce, state);
+
+#ifdef __AVX2__
+    while (size >= BLOCK_SIZE * 8)
+    {
+        xorBlocks8(data, state);
+
+        mCounter += 8;
+        state[12] = static_cast<uint32_t>(mCounter);
+        state[13] = static_cast<uint32_t>(mCounter >> 32);
+        data += BLOCK_SIZE * 8;
+        size -= BLOCK_SIZE * 8;
+    }
+#endif
+
+    while (size >= BLOCK_SIZE * 4)
+    {
+        xorBlocks4(data, state);
+
+        mCounter += 4;
+        state[12] = static_cast<uint32_t>(mCounter);
+        state[13] = static_cast<uint32_t>(mCounter >> 32);
+        data += BLOCK_SIZE * 4;
+        size -= BLOCK_SIZE * 4;
+    }
+
+    while (size > 0)
+    {
+        generateBlock(state, mKeyStream);
+
+        mCounter++;
+        state[12] = static_cast<uint32_t>(mCounter);
+        state[13] = static_cast<uint32_t>(mCounter >> 32);
+
+        const uint32_t xorSize = (size < BLOCK_SIZE) ? size : BLOCK_SIZE;
+
+        for (uint32_t i = 0; i < xorSize; ++i)
+        {
+            data[i] ^= mKeyStream[i];
+        }
+
+        mKeyStreamOffset = xorSize;
+        data += xorSize;
+        size -= xorSize;
+    }
+}
+
+inline void ChaCha20::Block(const uint8_t key[KEY_SIZE], const uint64_t counter, const uint64_t nonce, uint8_t out[BLOCK_SIZE])
+{
+    uint32_t keyWords[8];
+    memcpy(keyWords, key, KEY_SIZE);
+
+    uint32_t state[16];
+    makeState(keyWords, counter, nonce, state);
+
+    generateBlock(state, out);
+}
+
+inline void ChaCha20::generateBlock(const uint32_t state[16], uint8_t out[BLOCK_SIZE])
+{
+    uint32_t x[16];
+    memcpy(x, state, sizeof(x));
+
+    // 10   ( -> 밢)
+    for (int i = 0; i < 10; ++i)
+    {
+        ChaCha20Detail::QuarterRound(x, 0, 4, 8, 12);
+        ChaCha20Detail::QuarterRound(x, 1, 5, 9, 13);
+        ChaCha20Detail::QuarterRound(x, 2, 6, 10, 14);
+        ChaCha20Detail::QuarterRound(x, 3, 7, 11, 15);
+        ChaCha20Detail::QuarterRound(x, 0, 5, 10, 15);
+        ChaCha20Detail::QuarterRound(x, 1, 6, 11, 12);
+        ChaCha20Detail::QuarterRound(x, 2, 7, 8, 13);
+        ChaCha20Detail::QuarterRound(x, 3, 4, 9, 14);
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        x[i] += state[i];
+    }
+
+    memcpy(out, x, BLOCK_SIZE);
+}
+
+inline void ChaCha20::xorBlocks4(char* data, const uint32_t state[16])
+{
+    //  ϳ 4  带 ´ ( = )
+    __m128i input[16];
+
+    for (int i = 0; i < 16; ++i)
+    {
+        input[i] = _mm_set1_epi32(static_cast<int>(state[i]));
+    }
+
+    input[12] = _mm_setr_epi32(static_cast<int>(state[12]), static_cast<int>(state[12] + 1), static_cast<int>(state[12] + 2), static_cast<int>(state[12] + 3));
+    input[13] = _mm_setr_epi32(static_cast<int>(state[13]), static_cast<int>(ChaCha20Detail::CounterHigh(state, 1)), static_cast<int>(ChaCha20Detail::CounterHigh(state, 2)), static_cast<int>(ChaCha20Detail::CounterHigh(state, 3)));
+
+    __m128i x[16];
+    memcpy(x, input, sizeof(x));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ChaCha20Detail::QuarterRound(x[0], x[4], x[8], x[12]);
+        ChaCha20Detail::QuarterRound(x[1], x[5], x[9], x[13]);
+        ChaCha20Detail::QuarterRound(x[2], x[6], x[10], x[14]);
+        ChaCha20Detail::QuarterRound(x[3], x[7], x[11], x[15]);
+        ChaCha20Detail::QuarterRound(x[0], x[5], x[10], x[15]);
+        ChaCha20Detail::QuarterRound(x[1], x[6], x[11], x[12]);
+        ChaCha20Detail::QuarterRound(x[2], x[7], x[8], x[13]);
+        ChaCha20Detail::QuarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    //  4 ġؼ Ϻ 16Ʈ   XOR
+    for (int group = 0; group < 4; ++group)
+    {
+        const __m128i w0 = _mm_add_epi32(x[group * 4 + 0], input[group * 4 + 0]);
+        const __m128i w1 = _mm_add_epi32(x[group * 4 + 1], input[group * 4 + 1]);
+        const __m128i w2 = _mm_add_epi32(x[group * 4 + 2], input[group * 4 + 2]);
+        const __m128i w3 = _mm_add_epi32(x[group * 4 + 3], input[group * 4 + 3]);
+
+        const __m128i t0 = _mm_unpacklo_epi32(w0, w1);
+        const __m128i t1 = _mm_unpacklo_epi32(w2, w3);
+        const __m128i t2 = _mm_unpackhi_epi32(w0, w1);
+        const __m128i t3 = _mm_unpackhi_epi32(w2, w3);
+
+        ChaCha20Detail::XorBytes16(data + BLOCK_SIZE * 0 + group * 16, _mm_unpacklo_epi64(t0, t1));
+        ChaCha20Detail::XorBytes16(data + BLOCK_SIZE * 1 + group * 16, _mm_unpackhi_epi64(t0, t1));
+        ChaCha20Detail::XorBytes16(data + BLOCK_SIZE * 2 + group * 16, _mm_unpacklo_epi64(t2, t3));
+        ChaCha20Detail::XorBytes16(data + BLOCK_SIZE * 3 + group * 16, _mm_unpackhi_epi64(t2, t3));
+    }
+}
+
+#ifdef __AVX2__
+inline void ChaCha20::xorBlocks8(char* data, const uint32_t state[16])
+{
+    __m256i input[16];
+
+    for (int i = 0; i < 16; ++i)
+    {
+        input[i] = _mm256_set1_epi32(static_cast<int>(state[i]));
+    }
+
+    int counterLow[8];
+    int counterHigh[8];
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        counterLow[i] = static_cast<int>(state[12] + i);
+        counterHigh[i] = static_cast<int>(ChaCha20Detail::CounterHigh(state, i));
+    }
+
+    input[12] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterLow));
+    input[13] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterHigh));
+
+    __m256i x[16];
+    memcpy(x, input, sizeof(x));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ChaCha20Detail::QuarterRound(x[0], x[4], x[8], x[12]);
+        ChaCha20Detail::QuarterRound(x[1], x[5], x[9], x[13]);
+        ChaCha20Detail::QuarterRound(x[2], x[6], x[10], x[14]);
+        ChaCha20Detail::QuarterRound(x[3], x[7], x[11], x[15]);
+        ChaCha20Detail::QuarterRound(x[0], x[5], x[10], x[15]);
+        ChaCha20Detail::QuarterRound(x[1], x[6], x[11], x[12]);
+        ChaCha20Detail::QuarterRound(x[2], x[7], x[8], x[13]);
+        ChaCha20Detail::QuarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    // unpack 128Ʈ  ȿ ̹Ƿ  128Ʈ 0 ~ 3 ,  128Ʈ 4 ~ 7  ȴ
+    for (int group = 0; group < 4; ++group)
+    {
+        const __m256i w0 = _mm256_add_epi32(x[group * 4 + 0], input[group * 4 + 0]);
+        const __m256i w1 = _mm256_add_epi32(x[group * 4 + 1], input[group * 4 + 1]);
+        const __m256i w2 = _mm256_add_epi32(x[group * 4 + 2], input[group * 4 + 2]);
+        const __m256i w3 = _mm256_add_epi32(x[group * 4 + 3], input[group * 4 + 3]);
+
+        const __m256i t0 = _mm256_unpacklo_epi32(w0, w1);
+        const __m256i t1 = _mm256_unpacklo_epi32(w2, w3);
+        const __m256i t2 = _mm256_unpackhi_epi32(w0, w1);
+        const __m256i t3 = _mm256_unpackhi_epi32(w2, w3);
+
+        const __m256i blocks[4] =
+        {
+            _mm256_unpacklo_epi64(t0, t1),
+            _mm256_unpackhi_epi64(t0, t1),
+            _mm256_unpacklo_epi64(t2, t3),
+            _mm256_unpackhi_epi64(t2, t3)
+        };
+
+        for (int block = 0; block < 4; ++block)
+        {
+            ChaCha20Detail::XorBytes16(data + BLOCK_SIZE * block + group * 16, _mm256_castsi256_si128(blocks[block]));
+            ChaCha20Detail::XorBytes16(data + BLOCK_SIZE * (block + 4) + group * 16, _mm256_extracti128_si256(blocks[block], 1));
+        }
+    }
+}
+#endif
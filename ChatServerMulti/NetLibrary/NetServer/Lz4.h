@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// LZ4    (ุ , Ŭ̾Ʈ ǥ LZ4  ڴ(LZ4_decompress_safe) Ǯ  )
+// 4Ʈ ؽ÷  ֱ ġ ϳ ĺ  ܼ Ž -  KB  ä ޼  ̴ 뵵
+//  = [ū (ͷ  4Ʈ, ġ  - 4 4Ʈ)][ͷ  ߰ Ʈ][ͷ][ 2Ʈ][ġ  ߰ Ʈ]
+//  Ģ :  5Ʈ ׻ ͷ,  ġ  12Ʈ  ؾ 
+class Lz4
+{
+public:
+    enum : uint32_t
+    {
+        MAX_INPUT_SIZE = 0xFFFF     // ؽ ̺ 16Ʈ ġ ϹǷ ̺ ū Է  ʴ´
+    };
+
+    // source ؼ dest   ũ⸦ ȯ, destCapacity ȿ  Ѵٸ 0
+    // destCapacity  ũ⺸ ۰ ָ پ ʴ Է   ʰ ٷ Ѵ
+    static uint32_t Compress(const char* source, const uint32_t sourceSize, char* dest, const uint32_t destCapacity)
+    {
+        if (sourceSize > MAX_INPUT_SIZE)
+        {
+            return 0;
+        }
+
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(source);
+        uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+        uint8_t* const outEnd = out + destCapacity;
+
+        uint32_t anchor = 0;
+
+        if (sourceSize > MATCH_START_MARGIN)
+        {
+            uint16_t hashTable[HASH_TABLE_SIZE] = {};
+
+            const uint32_t matchStartLimit = sourceSize - MATCH_START_MARGIN;
+            const uint32_t matchEndLimit = sourceSize - LAST_LITERAL_SIZE;
+
+            uint32_t position = 0;
+
+            while (position < matchStartLimit)
+            {
+                const uint32_t sequence = read32(src + position);
+                const uint32_t hash = hashOf(sequence);
+                uint32_t candidate = hashTable[hash];
+
+                hashTable[hash] = static_cast<uint16_t>(position);
+
+                if (candidate >= position || read32(src + candidate) != sequence)
+                {
+                    position++;
+                    continue;
+                }
+
+                uint32_t matchLength = MIN_MATCH;
+
+                while (position + matchLength < matchEndLimit && src[candidate + matchLength] == src[position + matchLength])
+                {
+                    matchLength++;
+                }
+
+                // ε ø  ִٸ ͷ δ
+                while (position > anchor && candidate > 0 && src[position - 1] == src[candidate - 1])
+                {
+                    position--;
+                    candidate--;
+                    matchLength++;
+                }
+
+                out = writeSequence(out, outEnd, src + anchor, position - anchor, position - candidate, matchLength);
+                if (out == nullptr)
+                {
+                    return 0;
+                }
+
+                position += matchLength;
+                anchor = position;
+            }
+        }
+
+        out = writeLastLiterals(out, outEnd, src + anchor, sourceSize - anchor);
+        if (out == nullptr)
+        {
+            return 0;
+        }
+
+        return static_cast<uint32_t>(out - reinterpret_cast<uint8_t*>(dest));
+    }
+
+private:
+    enum : uint32_t
+    {
+        MIN_MATCH = 4,
+        LAST_LITERAL_SIZE = 5,
+        MATCH_START_MARGIN = 12,
+        HASH_LOG = 10,
+        HASH_TABLE_SIZE = 1 << HASH_LOG,
+        RUN_MASK = 15,
+        MAX_OFFSET = 0xFFFF
+    };
+
+    static inline uint32_t read32(const uint8_t* p)
+    {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t hashOf(const uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - HASH_LOG);
+    }
+
+    // ū   ߰ Ʈ (15 ̸̻ 255  )
+    static inline uint8_t* writeLength(uint8_t* out, uint32_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            *out++ = 255;
+        }
+
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    //  ϳ ,  ϴٸ nullptr
+    static uint8_t* writeSequence(uint8_t* out, const uint8_t* outEnd, const uint8_t* literals, const uint32_t literalLength, const uint32_t offset, const uint32_t matchLength)
+    {
+        const uint32_t extraMatchLength = matchLength - MIN_MATCH;
+        const size_t requiredSize = 1 + (literalLength / 255 + 1) + literalLength + sizeof(uint16_t) + (extraMatchLength / 255 + 1);
+
+        if (offset > MAX_OFFSET || static_cast<size_t>(outEnd - out) < requiredSize)
+        {
+            return nullptr;
+        }
+
+        uint8_t* token = out++;
+        *token = static_cast<uint8_t>(((literalLength < RUN_MASK) ? literalLength : RUN_MASK) << 4);
+
+        if (literalLength >= RUN_MASK)
+        {
+            out = writeLength(out, literalLength - RUN_MASK);
+        }
+
+        memcpy(out, literals, literalLength);
+        out += literalLength;
+
+        *out++ = static_cast<uint8_t>(offset);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+
+        *token |= static_cast<uint8_t>((extraMatchLength < RUN_MASK) ? extraMatchLength : RUN_MASK);
+
+        if (extraMatchLength >= RUN_MASK)
+        {
+            out = writeLength(out, extraMatchLength - RUN_MASK);
+        }
+
+        return out;
+    }
+
+    // ġ  ͷ ִ   ,  ϴٸ nullptr
+    static uint8_t* writeLastLiterals(uint8_t* out, const uint8_t* outEnd, const uint8_t* literals, const uint32_t literalLength)
+    {
+        const size_t requiredSize = 1 + (literalLength / 255 + 1) + literalLength;
+
+        if (static_cast<size_t>(outEnd - out) < requiredSize)
+        {
+            return nullptr;
+        }
+
+        *out++ = static_cast<uint8_t>(((literalLength < RUN_MASK) ? literalLength : RUN_MASK) << 4);
+
+        if (literalLength >= RUN_MASK)
+        {
+            out = writeLength(out, literalLength - RUN_MASK);
+        }
+
+        memcpy(out, literals, literalLength);
+        out += literalLength;
+
+        return out;
+    }
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#pragma comment(lib, "onecore.lib")
+
+#include <cstring>
+#include <cstdint>
+#include <Windows.h>
+
+#include "../CrashDump/CrashDump.h"
+
+//     ּ       (RingBuffer  ̽)
+// [mBuffer, mBuffer + capacity) [mBuffer + capacity, mBuffer + capacity * 2)  ޸̹Ƿ
+//  ߸   ׻   а   ִ
+//
+// - 뷮 Ҵ (64KB) ̸鼭 2 ŵ̾ Ѵ (ε  %  &  ó)
+// - Front, Rear  ʰ  Ű(uint32_t ÷ο ) 뷮 Rear - Front
+// -   ϳ ܵ ʿ䰡  뷮 ü   ִ
+class MirroredRingBuffer
+{
+public:
+    enum { DEFAULT_SIZE = 1024 * 64 };
+
+    MirroredRingBuffer() : MirroredRingBuffer(DEFAULT_SIZE) {}
+    MirroredRingBuffer(int bufferSize);
+    ~MirroredRingBuffer();
+
+    inline void  ClearBuffer(void) { mFront = mRear = 0; }
+
+    inline int   GetCapacity(void) const { return static_cast<int>(mCapacity); }
+    inline int   GetUseSize(void) const { return static_cast<int>(mRear - mFront); }
+    inline int   GetFreeSize(void) const { return static_cast<int>(mCapacity - (mRear - mFront)); }
+    inline char* GetFrontBufferPtr(void) const { return mBuffer + (mFront & mMask); }
+    inline char* GetRearBufferPtr(void) const { return mBuffer + (mRear & mMask); }
+    inline char* GetBufferPtr(void) const { return mBuffer; }
+    inline int   GetRearOffset(void) const { return static_cast<int>(mRear & mMask); }
+
+    //   ε ü  ּ  ũ (RIO    Offset + Length 뷮   ִ  )
+    inline int   GetMappedSize(void) const { return static_cast<int>(mCapacity * 2); }
+
+    //  ͷ ܺο ѹ濡   ִ  (׻   ü)
+    inline int GetDirectEnqueueSize(void) const { return GetFreeSize(); }
+
+    //  ͷ ܺο ѹ濡   ִ  (׻    ü)
+    inline int GetDirectDequeueSize(void) const { return GetUseSize(); }
+
+    inline bool Enqueue(const char* data, int dataSize)
+    {
+        if (GetFreeSize() < dataSize)
+        {
+            return false;
+        }
+
+        memcpy(GetRearBufferPtr(), data, dataSize);
+        mRear += dataSize;
+
+        return true;
+    }
+
+    inline bool Dequeue(char* data, int dataSize)
+    {
+        if (GetUseSize() < dataSize)
+        {
+            return false;
+        }
+
+        memcpy(data, GetFrontBufferPtr(), dataSize);
+        mFront += dataSize;
+
+        return true;
+    }
+
+    inline bool Peek(char* data, int dataSize) const
+    {
+        if (GetUseSize() < dataSize)
+        {
+            return false;
+        }
+
+        memcpy(data, GetFrontBufferPtr(), dataSize);
+
+        return true;
+    }
+
+    // Front  ̵(), ̵  θ ȯ
+    inline bool MoveFront(int size)
+    {
+        if (GetUseSize() < size)
+        {
+            return false;
+        }
+
+        mFront += size;
+
+        return true;
+    }
+
+    // Rear  ̵(ǹ  ), ̵  θ ȯ
+    inline bool MoveRear(int size)
+    {
+        if (GetFreeSize() < size)
+        {
+            return false;
+        }
+
+        mRear += size;
+
+        return true;
+    }
+private:
+    char*       mBuffer;
+    HANDLE      mSection;
+    uint32_t    mCapacity;
+    uint32_t    mMask;
+    uint32_t    mFront = 0;
+    uint32_t    mRear = 0;
+};
+
+inline MirroredRingBuffer::MirroredRingBuffer(int bufferSize)
+    : mCapacity(static_cast<uint32_t>(bufferSize))
+    , mMask(static_cast<uint32_t>(bufferSize) - 1)
+{
+    SYSTEM_INFO systemInfo;
+    ::GetSystemInfo(&systemInfo);
+
+    if (bufferSize <= 0 || (mCapacity & mMask) != 0 || mCapacity % systemInfo.dwAllocationGranularity != 0)
+    {
+        CrashDump::Crash();
+    }
+
+    // 1. 뷮ŭ     
+    mSection = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, mCapacity, nullptr);
+    if (mSection == nullptr)
+    {
+        CrashDump::Crash();
+    }
+
+    // 2. 뷮 * 2 ũ placeholder    
+    char* placeholder = static_cast<char*>(::VirtualAlloc2(nullptr, nullptr, static_cast<SIZE_T>(mCapacity) * 2, MEM_RESERVE | MEM_RESERVE_PLACEHOLDER, PAGE_NOACCESS, nullptr, 0));
+    if (placeholder == nullptr)
+    {
+        CrashDump::Crash();
+    }
+
+    if (FALSE == ::VirtualFree(placeholder, mCapacity, MEM_RELEASE | MEM_PRESERVE_PLACEHOLDER))
+    {
+        CrashDump::Crash();
+    }
+
+    // 3.  placeholder   
+    void* firstView = ::MapViewOfFile3(mSection, nullptr, placeholder, 0, mCapacity, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE, nullptr, 0);
+    void* secondView = ::MapViewOfFile3(mSection, nullptr, placeholder + mCapacity, 0, mCapacity, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE, nullptr, 0);
+    if (firstView == nullptr || secondView == nullptr)
+    {
+        CrashDump::Crash();
+    }
+
+    mBuffer = placeholder;
+}
+
+inline MirroredRingBuffer::~MirroredRingBuffer()
+{
+    ::UnmapViewOfFile(mBuffer);
+    ::UnmapViewOfFile(mBuffer + mCapacity);
+    ::CloseHandle(mSection);
+}
@@ -1,14 +1,88 @@
 #pragma comment(lib, "winmm")
+#pragma comment(lib, "ntdll")
+#pragma comment(lib, "bcrypt")
 
 #include <iostream>
+#include <algorithm>
 #include <process.h>
+#include <intrin.h>
+#include <winternl.h>
+#include <bcrypt.h>
 
 #include "NetUtils.h"
 #include "NetServer.h"
 #include "NetworkHeader.h"
 #include "Session.h"
+#include "Lz4.h"
 #include "../Tool/CpuUsageMonitor.h"
 
+// Ŀ ϳ ϴ RIO Ϸ ť
+struct RioCompletionQueue
+{
+	enum { DEQUEUE_BATCH_SIZE = 256 }; // RIODequeueCompletion()    ִ Ϸ 
+
+	RIO_CQ		CQ;
+	SRWLOCK		Lock;				// RIODequeueCompletion, RIONotify, RIOCreateRequestQueue ȭ
+	OVERLAPPED	NotifyOverlapped;	// RIONotify()   IOCP   Ǵ OVERLAPPED
+};
+
+// AcceptEx ϳ  ؽƮ (Ŀ  Accept )
+struct AcceptContext
+{
+	enum
+	{
+		ACCEPT_EX_COUNT_PER_WORKER = 64,				// Ŀ ̸ ɾδ AcceptEx 
+		ADDRESS_LENGTH = sizeof(SOCKADDR_IN) + 16		// AcceptEx 䱸ϴ ּ  ũ
+	};
+
+	//   IOCP(completion key = NetServer)  ؽƮ   ؾ  
+	enum class EState : uint8_t
+	{
+		Posted,			// AcceptEx Ϸ  -  ȣ ϰ   Ŀ ѱ
+		HandedOff,		//  Ŀ Ѱܹ  -  Ŀ  
+		RetryPost		// Ͻ  AcceptEx  ߴ ؽƮ - ٽ Ǵ
+	};
+
+	OVERLAPPED	Overlapped;
+	SOCKET		Socket;									// Accept  (̸ )
+	uint32_t	ListenerIndex;							// AcceptEx Ŵ 
+	EState		State;
+	uint64_t	AcceptedCount;							// HandedOff - ̸ ޾Ƶ  ȣ ( ID  Ŀ )
+	char		AddressBuffer[ADDRESS_LENGTH * 2];		// [local address][remote address]
+};
+
+//  忡 ٸ 尡  ۽ û  Ŀ ϴ Inbox
+struct WorkerInbox
+{
+	struct Item
+	{
+		uint64_t	SessionID;
+		Serializer*	Packet;
+		bool		bDisconnectAfterSend;	// SendAndDisconnect() û
+	};
+
+	LockFreeQueue<Item>	Queue;
+	uint32_t			bDoorbell;				// 1̸ ̹  Ŀ   (ߺ PQCS )
+	OVERLAPPED			DoorbellOverlapped;		// Inbox  PQCS Ǵ OVERLAPPED
+};
+
+// ٸ 尡   ī͸ д´ (Ϳ ĳõ   ʵ volatile )
+static inline uint32_t readCounter(const uint32_t& counter)
+{
+	return *static_cast<const volatile uint32_t*>(&counter);
+}
+
+//  ð (ũ, QueryPerformanceCounter )
+static uint64_t getCurrentMicroseconds(void)
+{
+	static LARGE_INTEGER frequency = []() { LARGE_INTEGER f; ::QueryPerformanceFrequency(&f); return f; }();
+
+	LARGE_INTEGER counter;
+	::QueryPerformanceCounter(&counter);
+
+	return static_cast<uint64_t>(counter.QuadPart) * 1'000'000 / frequency.QuadPart;
+}
+
 NetServer::~NetServer()
 {
 	if (mbIsRunning)
@@ -22,37 +96,259 @@ void NetServer::Start(const uint16_t port, const uint32_t maxSessionCount, const
 	ASSERT_LIVE(iocpConcurrentThreadCount > 0, L"iocpConcurrentThreadCount can not be zero");
 	ASSERT_LIVE(iocpWorkerThreadCount > 0, L"iocpWorkerThreadCount can not be zero");
 
+	ASSERT_LIVE(maxSessionCount > 0 && maxSessionCount <= MAX_SESSION_TABLE_CAPACITY, L"maxSessionCount out of range");
+
 	mbIsRunning = true;
 
 	mPort = port;
 	mMaxSessionCount = maxSessionCount;
 	mThreadCount = iocpWorkerThreadCount + 2;
 
+	// Start() Ʈ ⺻    (AddListener() ߰  ڿ д)
+	ASSERT_LIVE(AddListener(port, DEFAULT_NETWORK_HEADER_PROFILE), L"AddListener() failed (too many listeners or duplicated port)");
+
 	if (mMaxPayloadLength == 0)
 	{
 		mMaxPayloadLength = UINT16_MAX;
 	}
 
+	if (mSendGatherByteBudget == 0)
+	{
+		mSendGatherByteBudget = 64 * 1024;
+	}
+
+	if (mSendLingerMicroseconds > 0 && mSendLingerBytes == 0)
+	{
+		mSendLingerBytes = mSendGatherByteBudget;
+	}
+
+	if (mCompletionBatchSize == 0)
+	{
+		mCompletionBatchSize = 64;
+	}
+	else if (mCompletionBatchSize > MAX_COMPLETION_BATCH_SIZE)
+	{
+		mCompletionBatchSize = MAX_COMPLETION_BATCH_SIZE;
+	}
+
 	::timeBeginPeriod(1);
 
 	NetUtils::WSAStartup();
 
-	mIOCP = NetUtils::CreateNewIOCP(iocpConcurrentThreadCount);
+	// RIO Ϸ ť Ŀ ϳ ιǷ IOCP Ŀ ϳ ʿϴ
+	if (mIoEngine == EIoEngine::Rio && !mbIsIocpPerWorker)
+	{
+		mbIsIocpPerWorker = true;
+		LOGF(ELogLevel::System, L"RIO engine requires IOCP per worker - option enabled");
+	}
+
+	//    Ϸ  ׻  Ŀ  Ѵ
+	if (mbIsSharded && !mbIsIocpPerWorker)
+	{
+		mbIsIocpPerWorker = true;
+		LOGF(ELogLevel::System, L"Sharded mode requires IOCP per worker - option enabled");
+	}
+
+	//   Ǯ  WSARecv 0Ʈ ſ ϸ  ۸ ٲ   ־ Ѵ
+	if (mbIsPooledRecvBuffer && (mIoEngine == EIoEngine::Rio || SESSION_RECV_BUFFER_USE_MIRRORED))
+	{
+		mbIsPooledRecvBuffer = false;
+		LOGF(ELogLevel::System, L"Pooled recv buffer is not supported with RIO engine or mirrored recv buffer - option disabled");
+	}
+
+	if (mbIsPooledRecvBuffer)
+	{
+		mRecvBufferPool = new LockFreeObjectPool<RecvBufferBlock>();
+		LOGF(ELogLevel::System, L"Pooled recv buffer (buffer size = %d)", RingBuffer::DEFAULT_SIZE);
+	}
+
+	//  v2 NET   ״  hello NET  Ѵ (NET  ʷ  Ǹ )
+	if (mbIsProtocolV2 && std::none_of(mListeners, mListeners + mListenerCount, [](const Listener& listener) { return listener.HeaderProfile == ENetworkHeaderProfile::Net; }))
+	{
+		mbIsProtocolV2 = false;
+		LOGF(ELogLevel::System, L"Protocol v2 requires NET network header listener - option disabled");
+	}
+
+	if (mbIsProtocolV2)
+	{
+		LOGF(ELogLevel::System, L"Protocol v2 enabled (ChaCha20 stream, v1 clients are accepted on the same port)");
+	}
+
+	// Ƽ ޽  NET  Code Ϲ Ӱ Ѵ (NET  ʷ  Ǹ )
+	if (mbIsMultiMessageFrame && std::none_of(mListeners, mListeners + mListenerCount, [](const Listener& listener) { return listener.HeaderProfile == ENetworkHeaderProfile::Net; }))
+	{
+		mbIsMultiMessageFrame = false;
+		LOGF(ELogLevel::System, L"Multi-message frame requires NET network header listener - option disabled");
+	}
+
+	if (mbIsMultiMessageFrame)
+	{
+		LOGF(ELogLevel::System, L"Multi-message frame enabled (per session, negotiated by contents)");
+	}
+
+	// ົ NET  Code Ϲ Ŷ Ѵ (NET  ʷ  Ǹ )
+	if (mCompressionThreshold != 0 && std::none_of(mListeners, mListeners + mListenerCount, [](const Listener& listener) { return listener.HeaderProfile == ENetworkHeaderProfile::Net; }))
+	{
+		mCompressionThreshold = 0;
+		LOGF(ELogLevel::System, L"Compression requires NET network header listener - option disabled");
+	}
+
+	if (mCompressionThreshold != 0)
+	{
+		LOGF(ELogLevel::System, L"Compression enabled (LZ4 block, payload >= %u bytes, per session, negotiated by contents)", mCompressionThreshold);
+	}
+
+	//  ӵ  - ϳ Ǿ     ū 
+	mbIsRecvRateLimited = mRecvPacketsPerSecond != 0 || mRecvBytesPerSecond != 0 || mRecvRateLimitTypeCount != 0;
+
+	if (mbIsRecvRateLimited)
+	{
+		LOGF(ELogLevel::System, L"Recv rate limit (policy %d, %u packets/s, %u bytes/s, %u packet type limits)", static_cast<int>(mRecvRateLimitPolicy), mRecvPacketsPerSecond, mRecvBytesPerSecond, mRecvRateLimitTypeCount);
+	}
+
+	// Create IOCPs
+	if (mbIsIocpPerWorker)
+	{
+		// Ŀ ϳ IOCP ϳ ϹǷ     1 
+		mIOCPCount = iocpWorkerThreadCount;
+		mIOCPs = new HANDLE[mIOCPCount];
+
+		for (uint32_t i = 0; i < mIOCPCount; ++i)
+		{
+			mIOCPs[i] = NetUtils::CreateNewIOCP(1);
+		}
+
+		LOGF(ELogLevel::System, L"IOCP per worker (IOCP count = %u, concurrent thread count ignored)", mIOCPCount);
+	}
+	else
+	{
+		mIOCPCount = 1;
+		mIOCPs = new HANDLE[mIOCPCount];
+		mIOCPs[0] = NetUtils::CreateNewIOCP(iocpConcurrentThreadCount);
+	}
+
+	// Create inboxes
+	if (mbIsSharded)
+	{
+		mInboxes = new WorkerInbox[mIOCPCount];
+
+		for (uint32_t i = 0; i < mIOCPCount; ++i)
+		{
+			mInboxes[i].bDoorbell = 0;
+			::ZeroMemory(&mInboxes[i].DoorbellOverlapped, sizeof(OVERLAPPED));
+		}
+
+		LOGF(ELogLevel::System, L"Sharded mode (shard count = %u)", mIOCPCount);
+	}
+
+	// Create RIO completion queues
+	if (mIoEngine == EIoEngine::Rio)
+	{
+		// RIO Լ ̺ RIO θ   ִ
+		SOCKET rioSocket = NetUtils::CreateSocket(true);
+		NetUtils::LoadRioFunctionTable(rioSocket);
+		NetUtils::CloseSocket(rioSocket);
+
+		mRioCompletionQueues = new RioCompletionQueue[mIOCPCount];
+
+		for (uint32_t i = 0; i < mIOCPCount; ++i)
+		{
+			RioCompletionQueue* rioCompletionQueue = &mRioCompletionQueues[i];
+
+			::InitializeSRWLock(&rioCompletionQueue->Lock);
+			::ZeroMemory(&rioCompletionQueue->NotifyOverlapped, sizeof(OVERLAPPED));
+
+			RIO_NOTIFICATION_COMPLETION notification{};
+			notification.Type = RIO_IOCP_COMPLETION;
+			notification.Iocp.IocpHandle = mIOCPs[i];
+			notification.Iocp.CompletionKey = rioCompletionQueue;
+			notification.Iocp.Overlapped = &rioCompletionQueue->NotifyOverlapped;
+
+			//   Ŀ  𸣹Ƿ Ϸ ť ϳ   Send, Recv 1   ־ Ѵ
+			rioCompletionQueue->CQ = NetUtils::Rio().RIOCreateCompletionQueue(mMaxSessionCount * 2, &notification);
+			ASSERT_LIVE(rioCompletionQueue->CQ != RIO_INVALID_CQ, L"RIOCreateCompletionQueue() failed");
+
+			ASSERT_LIVE(NetUtils::Rio().RIONotify(rioCompletionQueue->CQ) == ERROR_SUCCESS, L"RIONotify() failed");
+		}
+
+		// ۽ ۴   ũ ϰ Ǹ  Ѵ
+		const size_t rioSendBufferSize = static_cast<size_t>(mMaxSessionCount) * Session::RIO_SEND_BUFFER_SIZE;
+
+		mRioSendBuffer = reinterpret_cast<char*>(::VirtualAlloc(NULL, rioSendBufferSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+		ASSERT_LIVE(mRioSendBuffer != nullptr, L"RIO send buffer VirtualAlloc() failed");
+
+		mRioSendBufferID = NetUtils::Rio().RIORegisterBuffer(mRioSendBuffer, static_cast<DWORD>(rioSendBufferSize));
+		ASSERT_LIVE(mRioSendBufferID != RIO_INVALID_BUFFERID, L"RIO send buffer RIORegisterBuffer() failed");
+	}
+
+	// Create listen sockets
+	for (uint32_t i = 0; i < mListenerCount; ++i)
+	{
+		Listener* listener = &mListeners[i];
+
+		listener->Server = this;
+		listener->AcceptThread = nullptr;
+		listener->Socket = NetUtils::CreateSocket(mIoEngine == EIoEngine::Rio);
+		NetUtils::BindSocket(listener->Socket, listener->Port);
+		NetUtils::SetSocketListen(listener->Socket);
 
-	// Create Sessions
-	mSessionList = new Session[mMaxSessionCount];
+		LOGF(ELogLevel::System, L"Listener %u (port = %u, header = %s)", i, listener->Port, listener->HeaderProfile == ENetworkHeaderProfile::Lan ? L"LAN" : L"NET");
+	}
+
+	// Ŀ  Accept  -   Ϸ  completion key NetServer ޴´
+	if (mbIsAcceptOnWorkers)
+	{
+		NetUtils::LoadAcceptExFunctions(mListeners[0].Socket);
+
+		for (uint32_t i = 0; i < mListenerCount; ++i)
+		{
+			NetUtils::RegisterIOCP(mListeners[i].Socket, mIOCPs[0], reinterpret_cast<ULONG_PTR>(this));
+		}
+
+		// [Ŀ][][ACCEPT_EX_COUNT_PER_WORKER]
+		mAcceptContextCount = iocpWorkerThreadCount * mListenerCount * AcceptContext::ACCEPT_EX_COUNT_PER_WORKER;
+		mAcceptContexts = new AcceptContext[mAcceptContextCount];
+
+		for (uint32_t i = 0; i < mAcceptContextCount; ++i)
+		{
+			mAcceptContexts[i].Socket = INVALID_SOCKET;
+			mAcceptContexts[i].ListenerIndex = (i / AcceptContext::ACCEPT_EX_COUNT_PER_WORKER) % mListenerCount;
+		}
+
+		LOGF(ELogLevel::System, L"Accept on worker threads (AcceptEx count = %u)", mAcceptContextCount);
+	}
 
-	for (uint32_t i = 0; i < mMaxSessionCount; ++i)
+	// Create session table -    ׸Ʈ   (RIO  ۽ , Ϸ ť ũⰡ ִ   ǹǷ  ̸ )
+	::InitializeSRWLock(&mSessionTableLock);
+	::ZeroMemory(mSessionSegments, sizeof(mSessionSegments));
+	mSessionSegmentCount = 0;
+	mSessionKeyCount = 0;
+
+	if (mIoEngine == EIoEngine::Rio)
 	{
-		mSessionList[i].bDisconnected = true;
-		mUnusedSessionKeys.Push(i);
+		while (mSessionKeyCount < mMaxSessionCount)
+		{
+			addSessionSegment();
+		}
 	}
 
+	// ͸ ī  [Ŀ][Accept ][]
+	mCounterBlockCount = GetWorkerThreadCount() + 2;
+	mCounterBlocks = new MonitoringCounterBlock[mCounterBlockCount]();
+
 	// Create threads
 	mThreads = new HANDLE[mThreadCount];
 
-	// AcceptThread
-	mThreads[0] = reinterpret_cast<HANDLE>(::_beginthreadex(nullptr, 0, acceptThread, this, 0, nullptr));
+	// AcceptThread - ʸ ϳ (Ŀ  Accept   , Accept  ڵ ʰ )
+	mThreads[0] = nullptr;
+
+	if (!mbIsAcceptOnWorkers)
+	{
+		for (uint32_t i = 0; i < mListenerCount; ++i)
+		{
+			mListeners[i].AcceptThread = reinterpret_cast<HANDLE>(::_beginthreadex(nullptr, 0, acceptThread, &mListeners[i], 0, nullptr));
+		}
+	}
 
 	// MonitorThread
 	mThreads[1] = reinterpret_cast<HANDLE>(::_beginthreadex(nullptr, 0, monitorThread, this, 0, nullptr));
@@ -72,45 +368,177 @@ void NetServer::Shutdown(void)
 
 	mbIsRunning = false;
 
-	// accept thread
-	::closesocket(mListenSocket);
+	// accept threads
+	for (uint32_t i = 0; i < mListenerCount; ++i)
+	{
+		::closesocket(mListeners[i].Socket);
+	}
 
 	// IOCP worker threads
 	for (uint32_t i = 0; i < mThreadCount - 2; ++i)
 	{
-		::PostQueuedCompletionStatus(mIOCP, 0, 0, 0);
+		::PostQueuedCompletionStatus(mIOCPs[i % mIOCPCount], 0, 0, 0);
 	}
 
 	for (uint32_t i = 0; i < mThreadCount; ++i)
 	{
+		if (mThreads[i] == nullptr)
+		{
+			continue;
+		}
+
 		::WaitForSingleObject(mThreads[i], INFINITE); // Multiple 64  Ƿ  X
+		::CloseHandle(mThreads[i]);
 	}
 
-	for (uint32_t i = 0; i < mThreadCount; ++i)
+	for (uint32_t i = 0; i < mListenerCount; ++i)
 	{
-		::CloseHandle(mThreads[i]);
+		if (mListeners[i].AcceptThread == nullptr)
+		{
+			continue;
+		}
+
+		::WaitForSingleObject(mListeners[i].AcceptThread, INFINITE);
+		::CloseHandle(mListeners[i].AcceptThread);
+		mListeners[i].AcceptThread = nullptr;
+	}
+
+	// Ϸ  ä ִ AcceptEx  
+	if (mbIsAcceptOnWorkers)
+	{
+		for (uint32_t i = 0; i < mAcceptContextCount; ++i)
+		{
+			if (mAcceptContexts[i].Socket != INVALID_SOCKET)
+			{
+				NetUtils::CloseSocket(mAcceptContexts[i].Socket);
+			}
+		}
+	}
+
+	if (mIoEngine == EIoEngine::Rio)
+	{
+		for (uint32_t i = 0; i < GetAllocatedSessionCount(); ++i)
+		{
+			NetUtils::Rio().RIODeregisterBuffer(findSessionOrNull(static_cast<uint64_t>(i) << 32)->RioRecvBufferID);
+		}
+
+		for (uint32_t i = 0; i < mIOCPCount; ++i)
+		{
+			NetUtils::Rio().RIOCloseCompletionQueue(mRioCompletionQueues[i].CQ);
+		}
+
+		NetUtils::Rio().RIODeregisterBuffer(mRioSendBufferID);
+		::VirtualFree(mRioSendBuffer, 0, MEM_RELEASE);
+
+		delete[] mRioCompletionQueues;
+		mRioCompletionQueues = nullptr;
+		mRioSendBuffer = nullptr;
+	}
+
+	for (uint32_t i = 0; i < mIOCPCount; ++i)
+	{
+		::CloseHandle(mIOCPs[i]);
 	}
 
-	::CloseHandle(mIOCP);
+	delete[] mIOCPs;
+	mIOCPs = nullptr;
 
 	delete[] mThreads;
 	mThreads = nullptr;
 
-	delete[] mSessionList;
-	mSessionList = nullptr;
+	//   ä ִ  ۸ Ǯ ݳ ( Ҹڿ  ʵ)
+	if (mbIsPooledRecvBuffer)
+	{
+		for (uint32_t i = 0; i < GetAllocatedSessionCount(); ++i)
+		{
+			findSessionOrNull(static_cast<uint64_t>(i) << 32)->releaseRecvBuffer();
+		}
+	}
+
+	for (uint32_t i = 0; i < mSessionSegmentCount; ++i)
+	{
+		delete[] mSessionSegments[i];
+		mSessionSegments[i] = nullptr;
+	}
+
+	uint32_t unusedSessionKey;
+
+	while (mUnusedSessionKeys.TryPop(unusedSessionKey))
+	{
+	}
+
+	mSessionSegmentCount = 0;
+	mSessionKeyCount = 0;
+
+	if (mbIsPooledRecvBuffer)
+	{
+		mRecvBufferPool->Clear();
+		delete mRecvBufferPool;
+		mRecvBufferPool = nullptr;
+	}
+
+	delete[] mAcceptContexts;
+	mAcceptContexts = nullptr;
+
+	// ޵  Inbox Ŷ 
+	if (mbIsSharded)
+	{
+		for (uint32_t i = 0; i < mIOCPCount; ++i)
+		{
+			WorkerInbox::Item item;
+
+			while (mInboxes[i].Queue.TryDequeue(item))
+			{
+				item.Packet->DecrementRefCount();
+			}
+		}
+
+		delete[] mInboxes;
+		mInboxes = nullptr;
+	}
 
 	mbIsTcpNodelay = false;
 	mbIsSendBufferSizeZero = false;
+	mbIsIocpPerWorker = false;
+	mIoEngine = EIoEngine::Iocp;
+	mbIsAcceptOnWorkers = false;
+	mbIsSharded = false;
+	mbIsWorkerAffinity = false;
+	mCompletionBatchSize = 0;
+	mbIsDeferredFlush = false;
+	mbIsZeroCopyReceive = false;
+	mbIsPooledRecvBuffer = false;
+	mbIsProtocolV2 = false;
+	mbIsMultiMessageFrame = false;
+	mCompressionThreshold = 0;
+	::SecureZeroMemory(mProtocolV2Key, sizeof(mProtocolV2Key));
+	mAcceptContextCount = 0;
 	mSessionAcceptedCount = 0;
 	mSessionDisconnectedCount = 0;
 	mPort = 0;
 	mMaxPayloadLength = 0;
+	mSendGatherByteBudget = 0;
+	mSendLingerMicroseconds = 0;
+	mSendLingerBytes = 0;
+	mSlowConsumerPolicy = ESlowConsumerPolicy::Disconnect;
+	mSendHighWatermarkBytes = 0;
+	mSendLowWatermarkBytes = 0;
+	mSendHighWatermarkPackets = 0;
+	mSendLowWatermarkPackets = 0;
+	mbIsRecvRateLimited = false;
+	mRecvRateLimitPolicy = ERecvRateLimitPolicy::Drop;
+	mRecvPacketsPerSecond = 0;
+	mRecvBytesPerSecond = 0;
+	mRecvRateLimitTypeCount = 0;
 	mSessionCount = 0;
 	mMaxSessionCount = 0;
 	mThreadCount = 0;
-	mIOCP = 0;
-	mListenSocket = INVALID_SOCKET;
-	::ZeroMemory(&mMonitoringVariables, sizeof(MonitoringVariables));
+	mIOCPCount = 0;
+	mWorkerIndexCounter = 0;
+	mListenerCount = 0;
+	delete[] mCounterBlocks;
+	mCounterBlocks = nullptr;
+	mCounterBlockCount = 0;
 	::ZeroMemory(&mMonitorResult, sizeof(MonitoringVariables));
 
 	LOGF(ELogLevel::System, L"Server Shutdown");
@@ -123,6 +551,20 @@ void NetServer::SendPacket(const uint64_t sessionID, Serializer* packet)
 		return;
 	}
 
+	//  忡   ʰ ѱǷ ⺻  Ϸ غѴ ( ٸ  ۽ ť   纻 ٲ)
+	if (mbIsSharded)
+	{
+		if (!packet->IsSendPrepared())
+		{
+			packet->prepareSend();
+		}
+
+		packet->IncrementRefCount();
+
+		routeSendPacket(sessionID, packet, false);
+		return;
+	}
+
 	Session* session = findSessionOrNull(sessionID);
 	if (session == nullptr)
 	{
@@ -139,92 +581,791 @@ void NetServer::SendPacket(const uint64_t sessionID, Serializer* packet)
 
 	if (!packet->IsSendPrepared())
 	{
-		packet->prepareSend();
+		packet->prepareSend(session->HeaderProfile);
+	}
+
+	if (!admitSendPacket(session, packet))
+	{
+		session->DecrementIoCount();
+		return;
 	}
 
 	packet->IncrementRefCount();
 
-	session->SendQueue.Enqueue(packet);
+	session->enqueueSendPacket(packet);
 
-	session->PostSend();
+	requestSend(session);
 
 	session->DecrementIoCount();
 }
 
-void NetServer::Disconnect(const uint64_t sessionID)
+uint32_t NetServer::SendPacketMulti(const uint64_t sessionIDs[], const size_t count, Serializer* packet)
 {
-	Session* session = findSessionOrNull(sessionID);
-	if (session == nullptr)
+	if (packet == nullptr || count == 0)
 	{
-		return;
+		return 0;
 	}
 
-	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
-
-	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+	// ޴ ǵ    ʰ ⺻  Ϸ غѴ ( ٸ  ۽ ť   纻 ٲ)
+	if (!packet->IsSendPrepared())
 	{
-		session->DecrementIoCount();
-		return;
+		packet->prepareSend();
 	}
 
-	LOGF(ELogLevel::Debug, L"NetServer::Disconnect(%llu)", session->ID);
-
-	InterlockedExchange8(reinterpret_cast<CHAR*>(&session->bDisconnectRegistered), true);
-	
-	::CancelIoEx(reinterpret_cast<HANDLE>(session->Socket), NULL); // ̹ ɷִ IO 
+	// ޴  ŭ   ÷ΰ,   ŭ    ǵ
+	packet->AddRefCount(static_cast<uint32_t>(count));
 
-	session->DecrementIoCount();
-}
+	uint32_t sentCount = 0;
+	uint32_t skippedCount = 0;
 
-void NetServer::SendAndDisconnect(const uint64_t sessionID, Serializer* packet)
-{
-	if (packet == nullptr)
+	if (mbIsSharded)
 	{
-		return;
-	}
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint64_t sessionID = sessionIDs[i];
+			const uint32_t ownerWorkerIndex = getOwnerWorkerIndex(sessionID);
 
-	Session* session = findSessionOrNull(sessionID);
-	if (session == nullptr)
-	{
-		return;
-	}
+			//   - ٷ ó (ϸ sendPacketOnOwner()  īƮ ǵ)
+			if (ownerWorkerIndex == l_workerIndex)
+			{
+				if (sendPacketOnOwner(sessionID, packet, false))
+				{
+					sentCount++;
+				}
 
-	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+				continue;
+			}
 
-	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
-	{
-		session->DecrementIoCount();
-		return;
-	}
+			// ̹ ٸ  ƴٸ Inbox  ʴ´ ( Ȯ  Ŀ )
+			Session* session = findSessionOrNull(sessionID);
+			if (session == nullptr || session->ID != sessionID)
+			{
+				skippedCount++;
+				continue;
+			}
 
-	// Disconnect register - SendPacket  κи ̰ 
-	session->bDisconnectRegistered = true;
+			WorkerInbox* inbox = &mInboxes[ownerWorkerIndex];
 
-	if (!packet->IsSendPrepared())
-	{
-		packet->prepareSend();
-	}
+			inbox->Queue.Enqueue({ sessionID, packet, false });
 
-	packet->IncrementRefCount();
+			if (std::find(l_multicastInboxes.begin(), l_multicastInboxes.end(), ownerWorkerIndex) == l_multicastInboxes.end())
+			{
+				l_multicastInboxes.push_back(ownerWorkerIndex);
+			}
 
-	session->SendQueue.Enqueue(packet);
+			sentCount++;
+		}
 
-	session->PostSend();
+		// Ŷ  Ŀ   
+		for (const uint32_t ownerWorkerIndex : l_multicastInboxes)
+		{
+			WorkerInbox* inbox = &mInboxes[ownerWorkerIndex];
 
-	session->DecrementIoCount();
-}
+			if (InterlockedExchange(&inbox->bDoorbell, 1) == 0)
+			{
+				::PostQueuedCompletionStatus(mIOCPs[ownerWorkerIndex], 0, reinterpret_cast<ULONG_PTR>(inbox), &inbox->DoorbellOverlapped);
+			}
+		}
 
-bool NetServer::GetSessionAddress(const uint64_t sessionID, SOCKADDR_IN* outAddress) const
-{
-	ASSERT_LIVE(outAddress != nullptr, L"GetSessionAddress() nullptr passed");
+		l_multicastInboxes.clear();
 
-	Session* session = findSessionOrNull(sessionID);
-	if (session == nullptr)
-	{
-		return false;
+		packet->ReleaseRefCount(skippedCount);
+
+		return sentCount;
 	}
 
-	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+	for (size_t i = 0; i < count; ++i)
+	{
+		const uint64_t sessionID = sessionIDs[i];
+
+		// ̹ ܼ   IoCount ǵ帮 ʰ Ѿ
+		Session* session = findSessionOrNull(sessionID);
+		if (session == nullptr || session->ID != sessionID)
+		{
+			continue;
+		}
+
+		int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+
+		if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+		{
+			session->DecrementIoCount();
+			continue;
+		}
+
+		if (!admitSendPacket(session, packet))
+		{
+			session->DecrementIoCount();
+			continue;
+		}
+
+		session->enqueueSendPacket(packet);
+
+		requestSend(session);
+
+		session->DecrementIoCount();
+
+		sentCount++;
+	}
+
+	packet->ReleaseRefCount(static_cast<uint32_t>(count) - sentCount);
+
+	return sentCount;
+}
+
+void NetServer::Disconnect(const uint64_t sessionID)
+{
+	Session* session = findSessionOrNull(sessionID);
+	if (session == nullptr)
+	{
+		return;
+	}
+
+	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+
+	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+	{
+		session->DecrementIoCount();
+		return;
+	}
+
+	LOGF(ELogLevel::Debug, L"NetServer::Disconnect(%llu)", session->ID);
+
+	InterlockedExchange8(reinterpret_cast<CHAR*>(&session->bDisconnectRegistered), true);
+
+	if (mIoEngine == EIoEngine::Rio)
+	{
+		// RIO û CancelIoEx()   Ƿ  ݾƼ ɷִ û з ϷŲ
+		::AcquireSRWLockExclusive(&session->RioLock);
+		session->TryClosesocket();
+		::ReleaseSRWLockExclusive(&session->RioLock);
+	}
+	else
+	{
+		::CancelIoEx(reinterpret_cast<HANDLE>(session->Socket), NULL); // ̹ ɷִ IO 
+	}
+
+	session->DecrementIoCount();
+}
+
+void NetServer::SendAndDisconnect(const uint64_t sessionID, Serializer* packet)
+{
+	if (packet == nullptr)
+	{
+		return;
+	}
+
+	if (mbIsSharded)
+	{
+		if (!packet->IsSendPrepared())
+		{
+			packet->prepareSend();
+		}
+
+		packet->IncrementRefCount();
+
+		routeSendPacket(sessionID, packet, true);
+		return;
+	}
+
+	Session* session = findSessionOrNull(sessionID);
+	if (session == nullptr)
+	{
+		return;
+	}
+
+	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+
+	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+	{
+		session->DecrementIoCount();
+		return;
+	}
+
+	// Disconnect register - SendPacket  κи ̰ 
+	session->bDisconnectRegistered = true;
+
+	if (!packet->IsSendPrepared())
+	{
+		packet->prepareSend(session->HeaderProfile);
+	}
+
+	packet->IncrementRefCount();
+
+	session->enqueueSendPacket(packet);
+
+	session->PostSend();
+
+	session->DecrementIoCount();
+}
+
+void NetServer::routeSendPacket(const uint64_t sessionID, Serializer* packet, const bool bDisconnectAfterSend)
+{
+	const uint32_t ownerWorkerIndex = getOwnerWorkerIndex(sessionID);
+
+	//   - ٷ ó
+	if (ownerWorkerIndex == l_workerIndex)
+	{
+		sendPacketOnOwner(sessionID, packet, bDisconnectAfterSend);
+		return;
+	}
+
+	// ٸ  -  Ŀ Inbox ְ,  Ŀ   ʴٸ 
+	WorkerInbox* inbox = &mInboxes[ownerWorkerIndex];
+
+	inbox->Queue.Enqueue({ sessionID, packet, bDisconnectAfterSend });
+
+	if (InterlockedExchange(&inbox->bDoorbell, 1) == 0)
+	{
+		::PostQueuedCompletionStatus(mIOCPs[ownerWorkerIndex], 0, reinterpret_cast<ULONG_PTR>(inbox), &inbox->DoorbellOverlapped);
+	}
+}
+
+bool NetServer::sendPacketOnOwner(const uint64_t sessionID, Serializer* packet, const bool bDisconnectAfterSend)
+{
+	Session* session = findSessionOrNull(sessionID);
+	if (session == nullptr)
+	{
+		packet->DecrementRefCount();
+		return false;
+	}
+
+	//  Ϸ  ó  ̶ IoCount ̹ Ƿ ٽ ø ʴ´
+	const bool bHoldIoCount = (session != l_processingSession);
+
+	if (bHoldIoCount)
+	{
+		int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+
+		if (retIoCount < 0)
+		{
+			session->DecrementIoCount();
+			packet->DecrementRefCount();
+			return false;
+		}
+	}
+
+	if (session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+	{
+		if (bHoldIoCount)
+		{
+			session->DecrementIoCount();
+		}
+
+		packet->DecrementRefCount();
+		return false;
+	}
+
+	if (bDisconnectAfterSend)
+	{
+		session->bDisconnectRegistered = true;
+	}
+	else if (!admitSendPacket(session, packet))
+	{
+		if (bHoldIoCount)
+		{
+			session->DecrementIoCount();
+		}
+
+		packet->DecrementRefCount();
+		return false;
+	}
+
+	session->enqueueSendPacket(packet);
+
+	requestSend(session);
+
+	if (bHoldIoCount)
+	{
+		session->DecrementIoCount();
+	}
+
+	return true;
+}
+
+bool NetServer::admitSendPacket(Session* session, const Serializer* packet)
+{
+	if (mSendHighWatermarkBytes == 0 && mSendHighWatermarkPackets == 0)
+	{
+		return true;
+	}
+
+	const uint32_t queueBytes = static_cast<uint32_t>(InterlockedCompareExchange(reinterpret_cast<LONG*>(&session->SendQueueBytes), 0, 0));
+	const uint32_t queueCount = session->getSendQueueCount();
+
+	const bool bAboveHighWatermark = (mSendHighWatermarkBytes != 0 && queueBytes >= mSendHighWatermarkBytes) || (mSendHighWatermarkPackets != 0 && queueCount >= mSendHighWatermarkPackets);
+	const bool bBelowLowWatermark = (mSendHighWatermarkBytes == 0 || queueBytes <= mSendLowWatermarkBytes) && (mSendHighWatermarkPackets == 0 || queueCount <= mSendLowWatermarkPackets);
+
+	//  尡 ƴ϶  ۽ 尡 ÿ ǴϹǷ ´ Interlockedθ ٲٰ,
+	//   ڽ   ǴѴ (  ̸̻ ,   ϸ ,  ̿  ¸ )
+	bool bSlowConsumer;
+
+	if (bAboveHighWatermark)
+	{
+		InterlockedExchange8(reinterpret_cast<CHAR*>(&session->bSlowConsumer), true);
+		bSlowConsumer = true;
+	}
+	else if (bBelowLowWatermark)
+	{
+		InterlockedExchange8(reinterpret_cast<CHAR*>(&session->bSlowConsumer), false);
+		bSlowConsumer = false;
+	}
+	else
+	{
+		bSlowConsumer = InterlockedOr8(reinterpret_cast<CHAR*>(&session->bSlowConsumer), 0) != 0;
+	}
+
+	if (!bSlowConsumer)
+	{
+		return true;
+	}
+
+	switch (mSlowConsumerPolicy)
+	{
+	case ESlowConsumerPolicy::Disconnect:
+	{
+		LOGF(ELogLevel::Debug, L"Slow consumer disconnect (sessionID = %llu, queued = %u bytes, %u packets)", session->ID, queueBytes, queueCount);
+
+		addCounter(&MonitoringCounterBlock::SlowConsumerDisconnectTPS);
+
+		Disconnect(session->ID);
+	}
+	return false;
+	case ESlowConsumerPolicy::DropOldest:
+	{
+		// ť   ִ  ۽ ť ȥ   Ŀ̴ ( ) - α     Ǵ Ŷ ǳʶٰ   droppable Ŷ 
+		if (mbIsSharded && session->dropOldestDroppablePacket())
+		{
+			addCounter(&MonitoringCounterBlock::DroppedSendPacketTPS);
+			return true;
+		}
+
+		//   ִ  Ŷ ٸ (Ǵ  尡 ƴ϶)  Ŷ droppable  , ƴ϶    Ƿ ´
+		if (packet->IsDroppable())
+		{
+			addCounter(&MonitoringCounterBlock::DroppedSendPacketTPS);
+			return false;
+		}
+
+		LOGF(ELogLevel::Debug, L"Slow consumer disconnect - nothing to drop (sessionID = %llu, queued = %u bytes, %u packets)", session->ID, queueBytes, queueCount);
+
+		addCounter(&MonitoringCounterBlock::SlowConsumerDisconnectTPS);
+
+		Disconnect(session->ID);
+	}
+	return false;
+	case ESlowConsumerPolicy::DropNew:
+	{
+		// α     Ǵ Ŷ   ʰ ´ (Ŭ̾Ʈ °  ߳ ʵ)
+		if (packet->IsDroppable())
+		{
+			addCounter(&MonitoringCounterBlock::DroppedSendPacketTPS);
+			return false;
+		}
+
+		LOGF(ELogLevel::Debug, L"Slow consumer disconnect - non-droppable packet (sessionID = %llu, queued = %u bytes, %u packets)", session->ID, queueBytes, queueCount);
+
+		addCounter(&MonitoringCounterBlock::SlowConsumerDisconnectTPS);
+
+		Disconnect(session->ID);
+	}
+	return false;
+	default:
+		ASSERT_LIVE(false, L"Invalid ESlowConsumerPolicy");
+	}
+
+	return false;
+}
+
+Serializer* NetServer::getCompressedPacket(Serializer* packet)
+{
+	Serializer* compressedPacket = packet->mCompressedPacket;
+
+	if (compressedPacket == nullptr)
+	{
+		LARGE_INTEGER beginCounter;
+		::QueryPerformanceCounter(&beginCounter);
+
+		// Ŷ  (NET) ڵǾ Ƿ  ǵ  Ѵ ([üũ][̷ε] Ǯ)
+		char decodedPayload[Serializer::DEFAULT_SIZE + 1];
+		const uint32_t payloadSize = packet->GetUseSize();
+		uint32_t compressedSize = 0;
+
+		// [ ][LZ4 ] -  ۾  ϹǷ  ̻  ʰ Ѵ
+		// Ŷ (DEFAULT_SIZE) ū ̷ε Ƿ   DEFAULT_SIZE 
+		if (payloadSize > sizeof(uint16_t) + 1 && payloadSize <= Serializer::DEFAULT_SIZE)
+		{
+			Serializer::decodeFrameTo(packet->GetFullBufferPointer(), decodedPayload);
+
+			compressedPacket = Serializer::Alloc();
+			*compressedPacket << static_cast<uint16_t>(payloadSize);
+			compressedSize = Lz4::Compress(decodedPayload + 1, payloadSize, compressedPacket->GetUserBufferPointer() + sizeof(uint16_t), payloadSize - sizeof(uint16_t) - 1);
+
+			if (compressedSize == 0)
+			{
+				compressedPacket->DecrementRefCount();
+			}
+		}
+
+		if (compressedSize == 0)
+		{
+			compressedPacket = packet;
+		}
+		else
+		{
+			compressedPacket->SetUseSize(sizeof(uint16_t) + compressedSize);
+			compressedPacket->mbDroppable = packet->mbDroppable;
+			compressedPacket->prepareSend<ENetworkHeaderProfile::Net>();
+			reinterpret_cast<NetNetworkHeader*>(compressedPacket->GetFullBufferPointer())->Code = NETWORK_HEADER_CODE_COMPRESSED;
+		}
+
+		LARGE_INTEGER endCounter;
+		::QueryPerformanceCounter(&endCounter);
+
+		addCounter(&MonitoringCounterBlock::CompressTPS);
+		addCounter(&MonitoringCounterBlock::CompressInputBytesTPS, payloadSize);
+		addCounter(&MonitoringCounterBlock::CompressOutputBytesTPS, compressedPacket->GetUseSize());
+		addCounter(&MonitoringCounterBlock::CompressTicksTPS, static_cast<uint32_t>(endCounter.QuadPart - beginCounter.QuadPart));
+
+		// ٸ  ÿ  ٸ  ົ     
+		Serializer* prevCompressedPacket = reinterpret_cast<Serializer*>(InterlockedCompareExchangePointer(reinterpret_cast<PVOID volatile*>(&packet->mCompressedPacket), compressedPacket, nullptr));
+
+		if (prevCompressedPacket != nullptr)
+		{
+			if (compressedPacket != packet)
+			{
+				compressedPacket->DecrementRefCount();
+			}
+
+			compressedPacket = prevCompressedPacket;
+		}
+	}
+
+	if (compressedPacket == packet)
+	{
+		return nullptr;
+	}
+
+	addCounter(&MonitoringCounterBlock::CompressedSendTPS);
+
+	return compressedPacket;
+}
+
+bool NetServer::AddListener(const uint16_t port, const ENetworkHeaderProfile headerProfile)
+{
+	if (mListenerCount >= MAX_LISTENER_COUNT)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < mListenerCount; ++i)
+	{
+		if (mListeners[i].Port == port)
+		{
+			return false;
+		}
+	}
+
+	Listener* listener = &mListeners[mListenerCount];
+
+	listener->Server = this;
+	listener->Socket = INVALID_SOCKET;
+	listener->Port = port;
+	listener->HeaderProfile = headerProfile;
+	listener->AcceptThread = nullptr;
+
+	mListenerCount++;
+
+	return true;
+}
+
+bool NetServer::AddRecvRateLimitForPacketType(const uint16_t packetType, const uint32_t packetsPerSecond)
+{
+	for (uint32_t i = 0; i < mRecvRateLimitTypeCount; ++i)
+	{
+		if (mRecvRateLimitTypes[i] == packetType)
+		{
+			mRecvRateLimitTypePacketsPerSecond[i] = packetsPerSecond;
+			return true;
+		}
+	}
+
+	if (mRecvRateLimitTypeCount >= MAX_RECV_RATE_LIMIT_TYPE_COUNT)
+	{
+		return false;
+	}
+
+	mRecvRateLimitTypes[mRecvRateLimitTypeCount] = packetType;
+	mRecvRateLimitTypePacketsPerSecond[mRecvRateLimitTypeCount] = packetsPerSecond;
+	mRecvRateLimitTypeCount++;
+
+	return true;
+}
+
+void NetServer::refillRecvTokens(Session* session)
+{
+	static_assert(static_cast<int>(MAX_RECV_RATE_LIMIT_TYPE_COUNT) == static_cast<int>(Session::RECV_RATE_LIMIT_TYPE_COUNT), "Session recv rate limit token count mismatch");
+
+	// ū  : Ŷ 1(Ǵ 1Ʈ) = 1'000'000,  ð(us) * ʴ 뷮 ŭ ä
+	enum : int64_t { TOKEN_SCALE = 1'000'000 };
+
+	const uint64_t now = getCurrentMicroseconds();
+
+	// ù ̶  ä
+	const uint64_t elapsed = (session->RecvTokenRefillMicroseconds == 0) ? UINT64_MAX : now - session->RecvTokenRefillMicroseconds;
+
+	session->RecvTokenRefillMicroseconds = now;
+
+	const auto refill = [elapsed](int64_t& tokens, const uint32_t perSecond, const int64_t bucketSize)
+		{
+			if (perSecond == 0 || tokens >= bucketSize)
+			{
+				return;
+			}
+
+			// Ŷ  ä ŭ ٸ  ʰ ٷ ä (   ÷ )
+			if (elapsed >= static_cast<uint64_t>((bucketSize - tokens) / perSecond))
+			{
+				tokens = bucketSize;
+				return;
+			}
+
+			tokens += static_cast<int64_t>(elapsed) * perSecond;
+		};
+
+	// Ŷ ũ 1 з, Ʈ Ŷ ִ ũ Ŷ 1    (ʴ Ʈ Ѻ ū Ŷ   ʵ)
+	const int64_t maxPacketBytes = static_cast<int64_t>(MAX_NETWORK_HEADER_SIZE) + mMaxPayloadLength;
+	const int64_t byteBucketSize = (std::max)(static_cast<int64_t>(mRecvBytesPerSecond), maxPacketBytes) * TOKEN_SCALE;
+
+	refill(session->RecvPacketTokens, mRecvPacketsPerSecond, static_cast<int64_t>(mRecvPacketsPerSecond) * TOKEN_SCALE);
+	refill(session->RecvByteTokens, mRecvBytesPerSecond, byteBucketSize);
+
+	for (uint32_t i = 0; i < mRecvRateLimitTypeCount; ++i)
+	{
+		refill(session->RecvTypePacketTokens[i], mRecvRateLimitTypePacketsPerSecond[i], static_cast<int64_t>(mRecvRateLimitTypePacketsPerSecond[i]) * TOKEN_SCALE);
+	}
+}
+
+bool NetServer::consumeRecvTokens(Session* session, const Serializer* packet)
+{
+	enum : int64_t { TOKEN_SCALE = 1'000'000 };
+
+	const int64_t byteCost = static_cast<int64_t>(packet->GetFullSize()) * TOKEN_SCALE;
+
+	if (mRecvBytesPerSecond != 0 && session->RecvByteTokens < byteCost)
+	{
+		return false;
+	}
+
+	// Ŷ ŸԺ  ִٸ ⺻ Ŷ     (̷ε   2Ʈ = Ŷ Ÿ)
+	int64_t* packetTokens = mRecvPacketsPerSecond != 0 ? &session->RecvPacketTokens : nullptr;
+
+	if (mRecvRateLimitTypeCount != 0 && packet->GetUseSize() >= sizeof(uint16_t))
+	{
+		uint16_t packetType;
+		::memcpy(&packetType, packet->GetUserBufferPointer(), sizeof(packetType));
+
+		for (uint32_t i = 0; i < mRecvRateLimitTypeCount; ++i)
+		{
+			if (mRecvRateLimitTypes[i] == packetType)
+			{
+				packetTokens = mRecvRateLimitTypePacketsPerSecond[i] != 0 ? &session->RecvTypePacketTokens[i] : nullptr;
+				break;
+			}
+		}
+	}
+
+	if (packetTokens != nullptr && *packetTokens < TOKEN_SCALE)
+	{
+		return false;
+	}
+
+	if (mRecvBytesPerSecond != 0)
+	{
+		session->RecvByteTokens -= byteCost;
+	}
+
+	if (packetTokens != nullptr)
+	{
+		*packetTokens -= TOKEN_SCALE;
+	}
+
+	return true;
+}
+
+void NetServer::requestSend(Session* session)
+{
+	// Ŀ 尡 ƴ϶ Ÿ̸, dirty Ʈ ó  Ƿ ٷ 
+	if (l_workerIndex == UINT32_MAX)
+	{
+		session->PostSend();
+		return;
+	}
+
+	// ۽  -  ũⰡ LingerBytes ѱ  Ÿ̸ӿ ÷ΰ     
+	if (session->LingerMicroseconds > 0 && session->SendQueueBytes < session->LingerBytes)
+	{
+		if (InterlockedExchange(&session->bLingerRegistered, 1) == 0)
+		{
+			// Ÿ̸ӿ ִ    ʵ IoCount Ƶд
+			session->IncrementIoCount();
+			l_lingerTimers.push({ getCurrentMicroseconds() + session->LingerMicroseconds, session });
+		}
+
+		return;
+	}
+
+	//  ۽ - dirty Ʈ ÷ΰ  GQCS    
+	if (mbIsDeferredFlush)
+	{
+		if (InterlockedExchange(&session->bFlushRegistered, 1) == 0)
+		{
+			// dirty Ʈ ִ    ʵ IoCount Ƶд
+			session->IncrementIoCount();
+			l_dirtySessions.push_back(session);
+		}
+
+		return;
+	}
+
+	session->PostSend();
+}
+
+void NetServer::flushDirtySessions(void)
+{
+	for (Session* session : l_dirtySessions)
+	{
+		// PostSend    ̿  Ŷ  ٽ ϵ  ִ
+		InterlockedExchange(&session->bFlushRegistered, 0);
+
+		session->PostSend();
+
+		session->DecrementIoCount();
+	}
+
+	l_dirtySessions.clear();
+}
+
+uint32_t NetServer::flushExpiredLingerSessions(void)
+{
+	if (l_lingerTimers.empty())
+	{
+		return INFINITE;
+	}
+
+	const uint64_t now = getCurrentMicroseconds();
+
+	while (!l_lingerTimers.empty())
+	{
+		const LingerTimer& timer = l_lingerTimers.top();
+
+		if (timer.ExpireMicroseconds > now)
+		{
+			// 1ms ̸ Ҵ 0  ٻ Ⱑ ǹǷ ø
+			return static_cast<uint32_t>((timer.ExpireMicroseconds - now + 999) / 1000);
+		}
+
+		Session* session = timer.LingerSession;
+		l_lingerTimers.pop();
+
+		InterlockedExchange(&session->bLingerRegistered, 0);
+
+		addCounter(&MonitoringCounterBlock::LingerFlushTPS);
+
+		session->PostSend();
+
+		session->DecrementIoCount();
+	}
+
+	return INFINITE;
+}
+
+void NetServer::drainInbox(WorkerInbox* inbox)
+{
+	//     ó   û  ٽ    ִ
+	InterlockedExchange(&inbox->bDoorbell, 0);
+
+	WorkerInbox::Item item;
+
+	while (inbox->Queue.TryDequeue(item))
+	{
+		sendPacketOnOwner(item.SessionID, item.Packet, item.bDisconnectAfterSend);
+	}
+}
+
+void NetServer::SetSessionSendLinger(const uint64_t sessionID, const uint32_t microseconds, const uint32_t bytes)
+{
+	Session* session = findSessionOrNull(sessionID);
+	if (session == nullptr)
+	{
+		return;
+	}
+
+	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+
+	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+	{
+		session->DecrementIoCount();
+		return;
+	}
+
+	session->LingerMicroseconds = microseconds;
+	session->LingerBytes = (bytes == 0) ? mSendGatherByteBudget : bytes;
+
+	session->DecrementIoCount();
+}
+
+bool NetServer::SetSessionMultiMessageFrame(const uint64_t sessionID)
+{
+	return mbIsMultiMessageFrame && enableSessionSendFeature(sessionID, &Session::bMultiMessageFrame);
+}
+
+bool NetServer::SetSessionCompression(const uint64_t sessionID)
+{
+	return mCompressionThreshold != 0 && enableSessionSendFeature(sessionID, &Session::bCompression);
+}
+
+bool NetServer::enableSessionSendFeature(const uint64_t sessionID, bool Session::* feature)
+{
+	Session* session = findSessionOrNull(sessionID);
+	if (session == nullptr)
+	{
+		return false;
+	}
+
+	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
+
+	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
+	{
+		session->DecrementIoCount();
+		return false;
+	}
+
+	// LAN  Code  Ŭ̾Ʈ Ϲ Ŷ   
+	bool ret = (session->HeaderProfile == ENetworkHeaderProfile::Net);
+
+	// ۽  ۽(Ǵ Enqueue)      Ƿ  ۽ź ȴ
+	if (ret)
+	{
+		session->*feature = true;
+	}
+
+	session->DecrementIoCount();
+
+	return ret;
+}
+
+bool NetServer::GetSessionAddress(const uint64_t sessionID, SOCKADDR_IN* outAddress) const
+{
+	ASSERT_LIVE(outAddress != nullptr, L"GetSessionAddress() nullptr passed");
+
+	Session* session = findSessionOrNull(sessionID);
+	if (session == nullptr)
+	{
+		return false;
+	}
+
+	int32_t retIoCount = static_cast<int32_t>(session->IncrementIoCount());
 
 	if (retIoCount < 0 || session->bDisconnected || session->bDisconnectRegistered || session->ID != sessionID)
 	{
@@ -239,34 +1380,26 @@ bool NetServer::GetSessionAddress(const uint64_t sessionID, SOCKADDR_IN* outAddr
 	return true;
 }
 
-unsigned int NetServer::acceptThread(void* netServerParam)
+unsigned int NetServer::acceptThread(void* listenerParam)
 {
 	LOGF(ELogLevel::System, L"Accept Thread Start (ID : %d)", ::GetCurrentThreadId());
 
-	NetServer* netServer = reinterpret_cast<NetServer*>(netServerParam);
-
-	// create socket
-	netServer->mListenSocket = NetUtils::CreateSocket();
-
-	// bind
-	NetUtils::BindSocket(netServer->mListenSocket, netServer->mPort);
+	Listener* listener = reinterpret_cast<Listener*>(listenerParam);
+	NetServer* netServer = listener->Server;
 
-	// listen
-	NetUtils::SetSocketListen(netServer->mListenSocket);
+	// Accept   ī  ù °  常  ( ʴ  Ͽ Interlocked)
+	l_counterBlock = (listener == &netServer->mListeners[0]) ? &netServer->mCounterBlocks[netServer->GetWorkerThreadCount()] : nullptr;
 
 	/************************* Server Listening Start *************************/
 
-	LOGF(ELogLevel::System, L"Accept Start (Port = %d)", netServer->mPort);
+	LOGF(ELogLevel::System, L"Accept Start (Port = %d)", listener->Port);
 
 	SOCKADDR_IN clientAddress{};	// Ŭ̾Ʈ ּ
-	uint32_t newSessionKey;			// ο  Key (  ü )
-	uint64_t newSessionID;			// ο  ID
-	Session* newSession;			// ο  ü
 
 	while (netServer->mbIsRunning)
 	{
 		// accept()
-		SOCKET clientSocket = NetUtils::GetAcceptedSocketOrInvalid(netServer->mListenSocket, &clientAddress);
+		SOCKET clientSocket = NetUtils::GetAcceptedSocketOrInvalid(listener->Socket, &clientAddress);
 
 		// error handling
 		if (clientSocket == INVALID_SOCKET)
@@ -283,241 +1416,638 @@ unsigned int NetServer::acceptThread(void* netServerParam)
 			CrashDump::Crash();
 		}
 
-		// socket option
-		NetUtils::SetLinger(clientSocket, 1, 0);
+		netServer->setupAcceptedSession(clientSocket, clientAddress, listener->HeaderProfile, netServer->issueAcceptedCount());
+	}
+
+	l_counterBlock = nullptr;
+
+	LOGF(ELogLevel::System, L"Accept Thread End (ID : %d)", ::GetCurrentThreadId());
+
+	return 0;
+}
+
+unsigned int NetServer::iocpWorkerThread(void* netServerParam)
+{
+	LOGF(ELogLevel::System, L"IOCP Worker Thread Start (ID : %d)", ::GetCurrentThreadId());
+
+	NetServer* netServer = reinterpret_cast<NetServer*>(netServerParam);
+
+	//  Ŀ  IOCP (IOCP ϳ  Ŀ  IOCP )
+	const uint32_t workerIndex = InterlockedIncrement(&netServer->mWorkerIndexCounter) - 1;
+	HANDLE iocp = netServer->mIOCPs[workerIndex % netServer->mIOCPCount];
+
+	l_workerIndex = workerIndex;
+	l_counterBlock = &netServer->mCounterBlocks[workerIndex];
+
+	// ھ 
+	if (netServer->mbIsWorkerAffinity)
+	{
+		SYSTEM_INFO systemInfo;
+		::GetSystemInfo(&systemInfo);
+
+		const DWORD_PTR affinityMask = 1ULL << (workerIndex % systemInfo.dwNumberOfProcessors % 64);
+		ASSERT_LIVE(::SetThreadAffinityMask(::GetCurrentThread(), affinityMask) != 0, L"SetThreadAffinityMask() failed");
+
+		LOGF(ELogLevel::System, L"IOCP Worker Thread %u pinned to core %u", workerIndex, workerIndex % systemInfo.dwNumberOfProcessors % 64);
+	}
+
+	//    Ŀ Inbox
+	WorkerInbox* inbox = netServer->mbIsSharded ? &netServer->mInboxes[workerIndex % netServer->mIOCPCount] : nullptr;
+
+	// RIO ̶  Ŀ ϴ Ϸ ť
+	RioCompletionQueue* rioCompletionQueue = nullptr;
+
+	if (netServer->mIoEngine == EIoEngine::Rio)
+	{
+		rioCompletionQueue = &netServer->mRioCompletionQueues[workerIndex % netServer->mIOCPCount];
+	}
+
+	// Ŀ  Accept   Ŀ  AcceptEx ʸ ̸ ɾд
+	if (netServer->mbIsAcceptOnWorkers)
+	{
+		const uint32_t acceptContextCountPerWorker = netServer->mListenerCount * AcceptContext::ACCEPT_EX_COUNT_PER_WORKER;
+
+		for (uint32_t i = 0; i < acceptContextCountPerWorker; ++i)
+		{
+			netServer->postAcceptEx(&netServer->mAcceptContexts[workerIndex * acceptContextCountPerWorker + i]);
+		}
+	}
+
+	//     ִ mCompletionBatchSize Ϸ   óѴ
+	OVERLAPPED_ENTRY entries[MAX_COMPLETION_BATCH_SIZE];
+	bool bExit = false;
 
-		if (netServer->mbIsSendBufferSizeZero)
+	while (netServer->mbIsRunning && !bExit)
+	{
+		//  Ϸ ó ߿  ۽ û Ǵ   
+		if (!l_dirtySessions.empty())
 		{
-			NetUtils::SetSendBufferSize(clientSocket, 0);
+			netServer->flushDirtySessions();
 		}
 
-		if (netServer->mbIsTcpNodelay)
+		// ۽  ð  ǵ ,   ð Ѵ
+		const DWORD timeout = netServer->flushExpiredLingerSessions();
+
+		ULONG entryCount = 0;
+
+		if (FALSE == ::GetQueuedCompletionStatusEx(iocp, entries, netServer->mCompletionBatchSize, &entryCount, timeout, FALSE))
 		{
-			NetUtils::SetTcpNodelay(clientSocket);
+			// Ÿ̸  (ó Ϸ  )
+			ASSERT_LIVE(::GetLastError() == WAIT_TIMEOUT, L"GetQueuedCompletionStatusEx() failed");
+			continue;
 		}
 
-		// ǸƮκ  ´
-		bool bPopSuccess = netServer->mUnusedSessionKeys.TryPop(newSessionKey);
+		//    Ϸ   ׷
+		{
+			unsigned long bucket;
+			_BitScanReverse(&bucket, entryCount);
+
+			if (bucket >= MonitoringVariables::COMPLETIONS_PER_WAKEUP_BUCKET_COUNT)
+			{
+				bucket = MonitoringVariables::COMPLETIONS_PER_WAKEUP_BUCKET_COUNT - 1;
+			}
+
+			netServer->addCounter(&MonitoringCounterBlock::CompletionsPerWakeupHistogram, bucket);
+		}
 
-		if (false == bPopSuccess)
+		for (ULONG i = 0; i < entryCount; ++i)
 		{
-			NetUtils::CloseSocket(clientSocket);
-			LOGF(ELogLevel::System, L"Max Session Count - Session Disconnected");
+			const DWORD transferredBytes = entries[i].dwNumberOfBytesTransferred;
+			Session* session = reinterpret_cast<Session*>(entries[i].lpCompletionKey);
+			OVERLAPPED* overlapped = entries[i].lpOverlapped;
+
+			if (overlapped == 0)
+			{
+				if (session == 0)
+				{
+					//   - ̹   óϰ  Ż
+					bExit = true;
+				}
+				else
+				{
+					// OnRelease û PQCS ó
+					netServer->OnRelease(reinterpret_cast<const uint64_t>(session));
+				}
+
+				continue;
+			}
+
+			//  I/O  δ OVERLAPPED::Internal(NTSTATUS) ´ (GQCS ȯ  )
+			const bool bSucceeded = overlapped->Internal == 0;
+
+			// AcceptEx Ϸ  (  completion key NetServer)
+			if (reinterpret_cast<NetServer*>(session) == netServer)
+			{
+				netServer->handleAcceptCompletion(reinterpret_cast<AcceptContext*>(overlapped), bSucceeded, workerIndex);
+				continue;
+			}
+
+			// RIO Ϸ ť  (  completion key  ƴϴ)
+			if (rioCompletionQueue != nullptr && overlapped == &rioCompletionQueue->NotifyOverlapped)
+			{
+				netServer->processRioCompletions(rioCompletionQueue);
+				continue;
+			}
+
+			// Inbox  (  completion key  ƴϴ)
+			if (inbox != nullptr && overlapped == &inbox->DoorbellOverlapped)
+			{
+				netServer->drainInbox(inbox);
+				continue;
+			}
+
+			if (!bSucceeded)
+			{
+				const ULONG errorCode = ::RtlNtStatusToDosError(static_cast<NTSTATUS>(overlapped->Internal));
+
+				switch (errorCode)
+				{
+				case ERROR_SEM_TIMEOUT:
+				{
+					LOGF(ELogLevel::Debug, L"Completion failed, error = %u (SEM_TIMEOUT) -> disconnect", errorCode);
+				}
+				break;
+				case ERROR_NETNAME_DELETED:
+				case ERROR_CONNECTION_ABORTED:
+				case ERROR_OPERATION_ABORTED:
+				{
+					ASSERT_LIVE(session != nullptr, L"Completion failed, but Session is nullptr");
+				}
+				break;
+				default:
+				{
+					LOGF(ELogLevel::Error, L"Completion failed, error = %u (NTSTATUS = 0x%08llX)", errorCode, static_cast<uint64_t>(overlapped->Internal));
+					CrashDump::Crash();
+				}
+				break;
+				}
+
+				//   ó
+
+				goto DECREMENT_IO_COUNT;
+			}
+
+			// Process Disconnect & Send & Recv
+			l_processingSession = session;
+
+			if (overlapped == &session->SendOverlapped)
+			{
+				netServer->handleSendCompletion(session);
+			}
+			else if (overlapped == &session->RecvOverlapped)
+			{
+				netServer->handleRecvCompletion(session, transferredBytes);
+			}
+			else
+			{
+				ASSERT_LIVE(false, L"Invalid OVERLAPPED");
+			}
+
+			l_processingSession = nullptr;
+
+
+		DECREMENT_IO_COUNT:
+
+			// ̹    IoCount 1 ν    ϴ ڵ
+			session->DecrementIoCount();
+		}
+	}
+
+	l_counterBlock = nullptr;
+
+	LOGF(ELogLevel::System, L"IOCP Worker Thread End (ID : %d)", ::GetCurrentThreadId());
+
+	return 0;
+}
+
+void NetServer::handleSendCompletion(Session* session)
+{
+	// release registered packets
+	uint32_t registeredPacketsCount = session->RegisteredPacketCount;
+	session->RegisteredPacketCount = 0;
+
+	for (uint32_t i = 0; i < registeredPacketsCount; ++i)
+	{
+		session->RegisteredPackets[i]->DecrementRefCount();
+	}
+
+	// ۽ ۿ ؼ  (RIO,  v2) ϴ  Ŷ Ƿ  Ѵ
+	registeredPacketsCount += session->CopiedPacketCount;
+	session->CopiedPacketCount = 0;
+
+	addCounter(&MonitoringCounterBlock::SendMessageTPS, registeredPacketsCount);
+	addCounter(&MonitoringCounterBlock::SendFlushTPS);
+
+	// ۽ 1ȸ Ŷ  ׷
+	if (registeredPacketsCount > 0)
+	{
+		unsigned long bucket;
+		_BitScanReverse(&bucket, registeredPacketsCount);
+
+		if (bucket >= MonitoringVariables::PACKETS_PER_SEND_BUCKET_COUNT)
+		{
+			bucket = MonitoringVariables::PACKETS_PER_SEND_BUCKET_COUNT - 1;
+		}
+
+		addCounter(&MonitoringCounterBlock::PacketsPerSendHistogram, bucket);
+	}
+
+	if (session->bDisconnectRegistered)
+	{
+		return;
+	}
+
+	ASSERT_LIVE(InterlockedExchange(&session->bSendFlag, 0) == 1, L"more than 1 Send Error");
+
+	session->PostSend();
+}
+
+void NetServer::handleRecvCompletion(Session* session, const uint32_t transferredBytes)
+{
+	if (session->HeaderProfile == ENetworkHeaderProfile::Lan)
+	{
+		processRecvCompletion<ENetworkHeaderProfile::Lan>(session, transferredBytes);
+	}
+	else
+	{
+		processRecvCompletion<ENetworkHeaderProfile::Net>(session, transferredBytes);
+	}
+}
+
+template <ENetworkHeaderProfile PROFILE>
+void NetServer::processRecvCompletion(Session* session, const uint32_t transferredBytes)
+{
+	using Header = NetworkHeaderOf<PROFILE>;
+
+	Header header{};
+
+	//   Ǯ  - 0Ʈ  Ϸ Ͱ ߴٴ  ̹Ƿ ۸   Ѵ
+	//    ̾ Ŵ  0Ʈ ϷǾ   óȴ
+	if (session->bZeroByteRecv)
+	{
+		session->bZeroByteRecv = false;
+		session->acquireRecvBuffer();
+		session->PostRecv();
+		return;
+	}
+
+	// ̹    ġ (WSARecv, RIOReceive    Rear  ʰ )
+	char* receivedData = session->RecvBuffer.GetRearBufferPtr();
+
+	session->RecvBuffer.MoveRear(transferredBytes);
+
+	//  
+	if (transferredBytes == 0 || session->bDisconnectRegistered)
+	{
+		return;
+	}
+
+	if constexpr (PROFILE == ENetworkHeaderProfile::Net)
+	{
+		//  v2 -  Ʈ    ٷ ȣȭ ( ó v1  , ̷ε )
+		if (session->Protocol == ESessionProtocol::V2)
+		{
+			session->RecvCipher.Process(receivedData, transferredBytes);
+		}
+		else if (session->Protocol == ESessionProtocol::Undecided)
+		{
+			if (false == handshakeProtocol(session))
+			{
+				return;
+			}
+
+			//  Ǵ ŭ  
+			if (session->Protocol == ESessionProtocol::Undecided)
+			{
+				session->PostRecv();
+				return;
+			}
+		}
+	}
+
+	if (mbIsRecvRateLimited)
+	{
+		refillRecvTokens(session);
+	}
+
+	//    Ϸῡ ϼ Ŷ Ƽ   (OnReceiveBatch)
+	Serializer* packets[MAX_RECV_BATCH_SIZE];
+	uint32_t packetCount = 0;
+	bool bDisconnect = false;
+
+	// packet loop
+	while (true)
+	{
+		// 1. header check
+		if (session->RecvBuffer.GetUseSize() < sizeof(Header))
+		{
+			break;
+		}
+
+		bool retPeek = session->RecvBuffer.Peek(reinterpret_cast<char*>(&header), sizeof(header));
+		ASSERT_LIVE(retPeek == true, L"RecvBuffer Peek() Error");
+
+		if constexpr (PROFILE == ENetworkHeaderProfile::Net)
+		{
+			// NetServer - code check
+			if (header.Code != NETWORK_HEADER_CODE)
+			{
+				bDisconnect = true;
+				break;
+			}
+		}
+
+		// 2. header Length check
+		if (header.Length > GetMaxPayloadLength())
+		{
+			bDisconnect = true;
+			break;
+		}
+
+		// 3. payload check
+		if (session->RecvBuffer.GetUseSize() < sizeof(Header) + header.Length)
+		{
+			if (session->RecvBuffer.GetFreeSize() <= 0)
+			{
+				bDisconnect = true;
+			}
+
+			break;
+		}
+
+		// 4. packet copy (or view)
+		Serializer* packet = Serializer::l_packetPool.Alloc();
+		packet->IncrementRefCount();
+		packet->Clear();
+		packet->setHeaderProfile<PROFILE>();
+
+		// Zero-copy  - Ŷ  ۿ  ʰ ̾ ִٸ  ʰ    ٷ ڵ, ȭ
+		// ü ۿ    ũ Viewε  ʴ´ ( Ŷ   ü ۷ ؾ ϹǷ)
+		const bool bView = mbIsZeroCopyReceive && header.Length <= packet->GetCapacity() && session->RecvBuffer.GetDirectDequeueSize() >= static_cast<int>(sizeof(Header) + header.Length);
+
+		if (bView)
+		{
+			// OnReceive  ϴ Ǯ ư ʵ  ϳ  Ƶд
+			packet->IncrementRefCount();
+			packet->attachView(session->RecvBuffer.GetFrontBufferPtr() + sizeof(Header), header.Length);
+
+			// Front  ѱ (  ɱ      )
+			session->RecvBuffer.MoveFront(sizeof(Header) + header.Length);
+		}
+		else
+		{
+			if (header.Length > packet->GetCapacity())
+			{
+				packet->DecrementRefCount();
+				bDisconnect = true;
+				break;
+			}
+
+			bool retDequeue = session->RecvBuffer.Dequeue(packet->GetFullBufferPointer(), header.Length + sizeof(Header));
+			ASSERT_LIVE(retDequeue == true, L"RecvBuffer Dequeue() Error");
+			packet->SetUseSize(header.Length);
+		}
+
+		if constexpr (PROFILE == ENetworkHeaderProfile::Net)
+		{
+			// NetServer - decode packet ( v2 Ʈ  ̹ ȣȭǷ üũ Ȯ)
+			const bool bValidPacket = (session->Protocol == ESessionProtocol::V2) ? packet->verifyCheckSum() : packet->decode();
+
+			if (false == bValidPacket)
+			{
+				if (bView)
+				{
+					packet->detachView();
+					packet->DecrementRefCount();
+				}
+
+				packet->DecrementRefCount();
+				bDisconnect = true;
+				break;
+			}
+		}
+
+		// 5. rate limit check
+		if (mbIsRecvRateLimited && !consumeRecvTokens(session, packet))
+		{
+			if (bView)
+			{
+				packet->detachView();
+				packet->DecrementRefCount();
+			}
+
+			packet->DecrementRefCount();
+
+			if (mRecvRateLimitPolicy == ERecvRateLimitPolicy::Disconnect)
+			{
+				LOGF(ELogLevel::Debug, L"Recv rate limit disconnect (sessionID = %llu)", session->ID);
+
+				addCounter(&MonitoringCounterBlock::RateLimitDisconnectTPS);
+				bDisconnect = true;
+				break;
+			}
+
+			addCounter(&MonitoringCounterBlock::ThrottledRecvPacketTPS);
+			continue;
+		}
+
+		// 6. batch
+		packets[packetCount++] = packet;
+
+		if (packetCount == MAX_RECV_BATCH_SIZE)
+		{
+			dispatchReceivedPackets(session, packets, packetCount);
+			packetCount = 0;
+		}
+	}
+
+	// 7. OnReceive() / OnReceiveBatch() -  ϴ ̶   ϼ Ŷ Ѵ
+	if (packetCount != 0)
+	{
+		dispatchReceivedPackets(session, packets, packetCount);
+	}
+
+	if (bDisconnect)
+	{
+		return;
+	}
+
+	//   Ǯ  - óϴ  Ͱ ٸ ۸ ݳϰ ٽ 0Ʈ  
+	if (session->RecvBuffer.GetUseSize() == 0)
+	{
+		session->releaseRecvBuffer();
+	}
+
+	// Post Recv
+	session->PostRecv();
+}
+
+bool NetServer::handshakeProtocol(Session* session)
+{
+	NetNetworkHeader header;
+
+	if (session->RecvBuffer.GetUseSize() < sizeof(header))
+	{
+		return true;
+	}
+
+	bool retPeek = session->RecvBuffer.Peek(reinterpret_cast<char*>(&header), sizeof(header));
+	ASSERT_LIVE(retPeek == true, L"RecvBuffer Peek() Error");
 
-			continue;
-		}
+	// hello ƴ϶ v1 Ŭ̾Ʈ - ߴ ۽ Ѵ
+	if (header.Code != NETWORK_HEADER_CODE_V2_HELLO)
+	{
+		InterlockedExchange8(reinterpret_cast<CHAR*>(&session->Protocol), static_cast<CHAR>(ESessionProtocol::V1));
+		session->PostSend();
+		return true;
+	}
 
-		// ο  ID 
-		newSessionID = (++(netServer->mSessionAcceptedCount) & (0x0000'0000'FFFF'FFFFULL)) | (static_cast<uint64_t>(newSessionKey) << 32);
+	if (header.Length != PROTOCOL_V2_NONCE_SIZE)
+	{
+		LOGF(ELogLevel::Debug, L"Invalid protocol v2 hello (sessionID = %llu, length = %u)", session->ID, header.Length);
+		return false;
+	}
 
-		//  
-		newSession = &netServer->mSessionList[newSessionKey];
-		
-		{
-			newSession->IncrementIoCount();
+	if (session->RecvBuffer.GetUseSize() < sizeof(header) + PROTOCOL_V2_NONCE_SIZE)
+	{
+		return true;
+	}
 
-			newSession->Init(clientSocket, clientAddress, netServer, newSessionID, newSessionKey);
+	uint64_t clientNonce;
+	uint64_t serverNonce;
 
-			NetUtils::RegisterIOCP(clientSocket, netServer->mIOCP, reinterpret_cast<ULONG_PTR>(newSession));
+	session->RecvBuffer.MoveFront(sizeof(header));
+	bool retDequeue = session->RecvBuffer.Dequeue(reinterpret_cast<char*>(&clientNonce), sizeof(clientNonce));
+	ASSERT_LIVE(retDequeue == true, L"RecvBuffer Dequeue() Error");
 
-			// accept log
-			//LOGF(ELogLevel::Debug, L"Accept - %s:%d", NetUtils::GetIpAddress(newSession->Address).c_str(), NetUtils::GetPortNumber(newSession->Address));
+	NTSTATUS retGenRandom = ::BCryptGenRandom(nullptr, reinterpret_cast<PUCHAR>(&serverNonce), sizeof(serverNonce), BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+	ASSERT_LIVE(BCRYPT_SUCCESS(retGenRandom), L"BCryptGenRandom() failed");
 
-			// monitoring
-			InterlockedIncrement(&netServer->mSessionCount);
+	//  Ű = ChaCha20( Ű,  ȣ = Ŭ̾Ʈ nonce, nonce =  nonce)  32Ʈ
+	// Ű ȯ ƴϹǷ  Ű    nonce    Ű   ִ (SetProtocolV2Key()   )
+	// ⺰ Ʈ   Ű nonce ٸ  (0 : Ŭ̾Ʈ -> , 1 :  -> Ŭ̾Ʈ)
+	uint8_t keyBlock[ChaCha20::BLOCK_SIZE];
+	ChaCha20::Block(mProtocolV2Key, clientNonce, serverNonce, keyBlock);
 
-			netServer->OnAccept(newSession->ID);
+	session->RecvCipher.Init(keyBlock, 0);
+	session->SendCipher.Init(keyBlock, 1);
+	::SecureZeroMemory(keyBlock, sizeof(keyBlock));
 
-			netServer->mMonitoringVariables.AcceptTPS++;
+	// hello ڿ ̾  ʹ ̹ ȣ (   ߷ִٸ   )
+	const int useSize = session->RecvBuffer.GetUseSize();
+	const int directDequeueSize = session->RecvBuffer.GetDirectDequeueSize();
 
-			newSession->PostRecv();
+	session->RecvCipher.Process(session->RecvBuffer.GetFrontBufferPtr(), directDequeueSize);
 
-			newSession->DecrementIoCount();
-		}
+	if (useSize > directDequeueSize)
+	{
+		session->RecvCipher.Process(session->RecvBuffer.GetBufferPtr(), useSize - directDequeueSize);
 	}
 
-	LOGF(ELogLevel::System, L"Accept Thread End (ID : %d)", ::GetCurrentThreadId());
+	//  hello ۽   տ  ΰ, ߴ Ŷ  ڿ ȣȭؼ ̾ 
+	//    ۽ Ƿ ⼭ ۽ ۸ ᵵ ȴ
+	char* sendBuffer = (mIoEngine == EIoEngine::Rio) ? session->RioSendBuffer : session->CopySendBuffer;
 
-	return 0;
-}
+	NetNetworkHeader* helloHeader = reinterpret_cast<NetNetworkHeader*>(sendBuffer);
+	helloHeader->Code = NETWORK_HEADER_CODE_V2_HELLO;
+	helloHeader->Length = PROTOCOL_V2_NONCE_SIZE;
+	helloHeader->RandKey = 0;
+	helloHeader->CheckSum = 0;
+	::memcpy(sendBuffer + sizeof(NetNetworkHeader), &serverNonce, sizeof(serverNonce));
 
-unsigned int NetServer::iocpWorkerThread(void* netServerParam)
-{
-	LOGF(ELogLevel::System, L"IOCP Worker Thread Start (ID : %d)", ::GetCurrentThreadId());
+	session->CipherSendPrefixBytes = sizeof(NetNetworkHeader) + PROTOCOL_V2_NONCE_SIZE;
 
-	NetServer* netServer = reinterpret_cast<NetServer*>(netServerParam);
+	InterlockedExchange8(reinterpret_cast<CHAR*>(&session->Protocol), static_cast<CHAR>(ESessionProtocol::V2));
+	session->PostSend();
 
-	bool retGQCS;
-	NetworkHeader header{};
+	return true;
+}
 
-	while (netServer->mbIsRunning)
+void NetServer::dispatchReceivedPackets(Session* session, Serializer* const packets[], const uint32_t packetCount)
+{
+	if (packetCount == 1)
 	{
-		DWORD transferredBytes = 0;
-		Session* session = 0;
-		OVERLAPPED* overlapped = 0;
+		OnReceive(session->ID, packets[0]);
+	}
+	else
+	{
+		OnReceiveBatch(session->ID, packets, packetCount);
+	}
 
-		retGQCS = ::GetQueuedCompletionStatus(netServer->mIOCP, &transferredBytes, reinterpret_cast<ULONG_PTR*>(&session), &overlapped, INFINITE);
+	for (uint32_t i = 0; i < packetCount; ++i)
+	{
+		Serializer* packet = packets[i];
 
-		if (retGQCS) // GQCS return TRUE
-		{
-			if (transferredBytes == 0 && overlapped == 0)
-			{
-				if (session == 0)
-				{
-					//   -  Ż
-					break;
-				}
-				else
-				{
-					// OnRelease û PQCS ó
-					netServer->OnRelease(reinterpret_cast<const uint64_t>(session));
-					continue;
-				}
-			}
-		}
-		else// GQCS return FALSE
+		if (packet->IsView())
 		{
-			int errorCode = ::GetLastError();
-
-			switch (errorCode)
-			{
-			case ERROR_SEM_TIMEOUT:
-			{
-				LOGF(ELogLevel::Debug, L"GQCS FALSE, GetLastError() = %d (SEM_TIMEOUT) -> disconnect", errorCode, ::WSAGetLastError());
-			}
-			break;
-			case ERROR_NETNAME_DELETED:
-			case ERROR_CONNECTION_ABORTED:
-			case ERROR_OPERATION_ABORTED:
+			//  OnReceive ı Ŷ  ִٸ  ۰    (   ʾ) ü ۷ ش
+			if (InterlockedCompareExchange(reinterpret_cast<LONG*>(&packet->mRefCount), 1, 1) == 1)
 			{
-				ASSERT_LIVE(session != nullptr, L"retGQCS FALSE, but Session is nullptr");
+				packet->detachView();
 			}
-			break;
-			default:
+			else
 			{
-				LOGF(ELogLevel::Error, L"GQCS FALSE, GetLastError() = %d, WSAGetLastError() = %d", errorCode, ::WSAGetLastError());
-				CrashDump::Crash();
-			}
-			break;
+				packet->detachViewToCopy();
+				addCounter(&MonitoringCounterBlock::RetainedViewCopyTPS);
 			}
 
-			//   ó
-
-			goto DECREMENT_IO_COUNT;
+			packet->DecrementRefCount();
 		}
+	}
 
-		// Process Disconnect & Send & Recv
-		if (overlapped == &session->SendOverlapped)
-		{
-			// release registered packets
-			uint32_t registeredPacketsCount = session->RegisteredPacketCount;
-			session->RegisteredPacketCount = 0;
-
-			InterlockedAdd64(reinterpret_cast<LONG64*>(&netServer->mMonitoringVariables.SendMessageTPS), registeredPacketsCount);
+	addCounter(&MonitoringCounterBlock::RecvMessageTPS, packetCount);
+}
 
-			for (uint32_t i = 0; i < registeredPacketsCount; ++i)
-			{
-				session->RegisteredPackets[i]->DecrementRefCount();
-			}
+void NetServer::processRioCompletions(RioCompletionQueue* rioCompletionQueue)
+{
+	RIORESULT results[RioCompletionQueue::DEQUEUE_BATCH_SIZE];
+	ULONG resultCount;
 
-			if (session->bDisconnectRegistered)
-			{
-				goto DECREMENT_IO_COUNT;
-			}
+	//    Ϸ ť   ϰ ó
+	do
+	{
+		::AcquireSRWLockExclusive(&rioCompletionQueue->Lock);
+		resultCount = NetUtils::Rio().RIODequeueCompletion(rioCompletionQueue->CQ, results, RioCompletionQueue::DEQUEUE_BATCH_SIZE);
+		::ReleaseSRWLockExclusive(&rioCompletionQueue->Lock);
 
-			ASSERT_LIVE(InterlockedExchange(&session->bSendFlag, 0) == 1, L"more than 1 Send Error");
+		ASSERT_LIVE(resultCount != RIO_CORRUPT_CQ, L"RIODequeueCompletion() RIO_CORRUPT_CQ");
 
-			session->PostSend();
-		}
-		else if (overlapped == &session->RecvOverlapped)
+		for (ULONG i = 0; i < resultCount; ++i)
 		{
-			session->RecvBuffer.MoveRear(transferredBytes);
-
-			//  
-			if (transferredBytes == 0 || session->bDisconnectRegistered)
-			{
-				goto DECREMENT_IO_COUNT;
-			}
+			Session* session = reinterpret_cast<Session*>(results[i].SocketContext);
+			OVERLAPPED* overlapped = reinterpret_cast<OVERLAPPED*>(results[i].RequestContext);
 
-			// packet loop
-			while (true)
+			//  û( ,  ) IoCount Ҹ Ѵ
+			if (results[i].Status == 0)
 			{
-				// 1. header check
-				if (session->RecvBuffer.GetUseSize() < sizeof(NetworkHeader))
-				{
-					break;
-				}
-
-				bool retPeek = session->RecvBuffer.Peek(reinterpret_cast<char*>(&header), sizeof(header));
-				ASSERT_LIVE(retPeek == true, L"RecvBuffer Peek() Error");
-
-#if NETWORK_HEADER_USE_TYPE == NETWORK_HEADER_TYPE_NET
-				// NetServer - code check
-				if (header.Code != NETWORK_HEADER_CODE)
-				{
-					goto DECREMENT_IO_COUNT;
-				}
-#endif
+				l_processingSession = session;
 
-				// 2. header Length check
-				if (header.Length > netServer->GetMaxPayloadLength())
+				if (overlapped == &session->SendOverlapped)
 				{
-					goto DECREMENT_IO_COUNT;
+					handleSendCompletion(session);
 				}
-
-				// 3. payload check
-				if (session->RecvBuffer.GetUseSize() < sizeof(NetworkHeader) + header.Length)
+				else if (overlapped == &session->RecvOverlapped)
 				{
-					if (session->RecvBuffer.GetFreeSize() <= 0)
-					{
-						goto DECREMENT_IO_COUNT;
-					}
-
-					break;
+					handleRecvCompletion(session, results[i].BytesTransferred);
 				}
-
-				// 4. packet copy
-				Serializer* packet = Serializer::l_packetPool.Alloc();
-				packet->IncrementRefCount();
-				packet->Clear();
-
-				bool retDequeue = session->RecvBuffer.Dequeue(packet->GetFullBufferPointer(), header.Length + sizeof(NetworkHeader));
-				ASSERT_LIVE(retDequeue == true, L"RecvBuffer Dequeue() Error");
-				packet->SetUseSize(header.Length);
-
-#if NETWORK_HEADER_USE_TYPE == NETWORK_HEADER_TYPE_NET
-				// NetServer - decode packet
-				if (false == packet->decode())
+				else
 				{
-					packet->DecrementRefCount();
-					goto DECREMENT_IO_COUNT;
+					ASSERT_LIVE(false, L"Invalid RIO RequestContext");
 				}
-#endif
-
-				// 5. OnReceive()
-				netServer->OnReceive(session->ID, packet);
 
-				InterlockedIncrement(&netServer->mMonitoringVariables.RecvMessageTPS);
+				l_processingSession = nullptr;
 			}
 
-			// Post Recv
-			session->PostRecv();
+			session->DecrementIoCount();
 		}
-		else
-		{
-			ASSERT_LIVE(false, L"Invalid OVERLAPPED");
-		}
-
-
-	DECREMENT_IO_COUNT:
-
-		// ̹    IoCount 1 ν    ϴ ڵ
-		session->DecrementIoCount();
-	}
+	} while (resultCount == RioCompletionQueue::DEQUEUE_BATCH_SIZE);
 
-	LOGF(ELogLevel::System, L"IOCP Worker Thread End (ID : %d)", ::GetCurrentThreadId());
+	//  Ϸᰡ  IOCP  ޵  (̹ Ϸᰡ ׿ִٸ  )
+	::AcquireSRWLockExclusive(&rioCompletionQueue->Lock);
+	int retRIONotify = NetUtils::Rio().RIONotify(rioCompletionQueue->CQ);
+	::ReleaseSRWLockExclusive(&rioCompletionQueue->Lock);
 
-	return 0;
+	ASSERT_LIVE(retRIONotify == ERROR_SUCCESS || retRIONotify == WSAEALREADY, L"RIONotify() failed");
 }
 
 unsigned int NetServer::monitorThread(void* netServerParam)
@@ -536,6 +2066,8 @@ unsigned int NetServer::monitorThread(void* netServerParam)
 
 	uint64_t sumCount = 0;
 
+	MonitoringCounterBlock lastTotal{};	//    ī 
+
 	while (netServer->mbIsRunning)
 	{
 		::Sleep(1'000);
@@ -549,12 +2081,36 @@ unsigned int NetServer::monitorThread(void* netServerParam)
 		netServer->mMonitorResult.ProcessorTimeKernel = cpuTime.GetProcessorTimeKernel();
 		netServer->mMonitorResult.ProcessTimeKernel = cpuTime.GetProcessTimeKernel();
 
-		// TPS
-		netServer->mMonitorResult.AcceptTPS = netServer->mMonitoringVariables.AcceptTPS;
-		netServer->mMonitorResult.RecvMessageTPS = netServer->mMonitoringVariables.RecvMessageTPS;
-		netServer->mMonitorResult.SendMessageTPS = netServer->mMonitoringVariables.SendMessageTPS;
-		netServer->mMonitorResult.RecvPendingTPS = netServer->mMonitoringVariables.RecvPendingTPS;
-		netServer->mMonitorResult.SendPendingTPS = netServer->mMonitoringVariables.SendPendingTPS;
+		// TPS - 庰 ī  տ    ʴ  Ѵ
+		MonitoringCounterBlock total{};
+
+		for (uint32_t i = 0; i < netServer->mCounterBlockCount; ++i)
+		{
+			const MonitoringCounterBlock& block = netServer->mCounterBlocks[i];
+
+#define X(name) total.name += readCounter(block.name);
+			NET_SERVER_TPS_COUNTER_LIST(X)
+#undef X
+#define X(name, count) for (uint32_t j = 0; j < (count); ++j) { total.name[j] += readCounter(block.name[j]); }
+			NET_SERVER_TPS_HISTOGRAM_LIST(X)
+#undef X
+		}
+
+#define X(name) netServer->mMonitorResult.name = total.name - lastTotal.name;
+		NET_SERVER_TPS_COUNTER_LIST(X)
+#undef X
+#define X(name, count) for (uint32_t j = 0; j < (count); ++j) { netServer->mMonitorResult.name[j] = total.name[j] - lastTotal.name[j]; }
+		NET_SERVER_TPS_HISTOGRAM_LIST(X)
+#undef X
+
+		lastTotal = total;
+
+		if (netServer->mbIsPooledRecvBuffer)
+		{
+			const uint32_t poolCapacity = netServer->mRecvBufferPool->GetCapacity();
+			netServer->mMonitorResult.RecvBufferPoolCapacity = poolCapacity;
+			netServer->mMonitorResult.RecvBufferPoolUseCount = poolCapacity - netServer->mRecvBufferPool->GetSize();
+		}
 
 		// Avg TPS
 		sumAcceptTPS += netServer->mMonitorResult.AcceptTPS;
@@ -569,13 +2125,6 @@ unsigned int NetServer::monitorThread(void* netServerParam)
 		netServer->mMonitorResult.AverageSendMessageTPS = static_cast<uint32_t>(sumSendMessageTPS / sumCount);
 		netServer->mMonitorResult.AverageRecvPendingTPS = static_cast<uint32_t>(sumRecvPendingTPS / sumCount);
 		netServer->mMonitorResult.AverageSendPendingTPS = static_cast<uint32_t>(sumSendPendingTPS / sumCount);
-
-		// ͸  ʱȭ
-		netServer->mMonitoringVariables.AcceptTPS = 0;
-		netServer->mMonitoringVariables.RecvMessageTPS = 0;
-		netServer->mMonitoringVariables.SendMessageTPS = 0;
-		netServer->mMonitoringVariables.RecvPendingTPS = 0;
-		netServer->mMonitoringVariables.SendPendingTPS = 0;
 	}
 
 	LOGF(ELogLevel::System, L"Monitor Thread End (ID : %d)", ::GetCurrentThreadId());
@@ -583,14 +2132,324 @@ unsigned int NetServer::monitorThread(void* netServerParam)
 	return 0;
 }
 
+void NetServer::setupAcceptedSession(const SOCKET clientSocket, const SOCKADDR_IN& clientAddress, const ENetworkHeaderProfile headerProfile, const uint64_t acceptedCount)
+{
+	uint32_t newSessionKey;			// ο  Key (  ü )
+	uint64_t newSessionID;			// ο  ID
+	Session* newSession;			// ο  ü
+
+	// socket option
+	NetUtils::SetLinger(clientSocket, 1, 0);
+
+	if (mbIsSendBufferSizeZero)
+	{
+		NetUtils::SetSendBufferSize(clientSocket, 0);
+	}
+
+	if (mbIsTcpNodelay)
+	{
+		NetUtils::SetTcpNodelay(clientSocket);
+	}
+
+	// ǸƮκ  ´ ( Ű ٸ  ̺ ÷)
+	while (false == mUnusedSessionKeys.TryPop(newSessionKey))
+	{
+		if (false == growSessionTable())
+		{
+			NetUtils::CloseSocket(clientSocket);
+			LOGF(ELogLevel::System, L"Max Session Count - Session Disconnected");
+
+			return;
+		}
+	}
+
+	// ο  ID  ( ȣ ȣڰ ̸ ޾Ƶ ,  Ŀ  ȣ )
+	newSessionID = (acceptedCount & (0x0000'0000'FFFF'FFFFULL)) | (static_cast<uint64_t>(newSessionKey) << 32);
+
+	//  
+	newSession = findSessionOrNull(newSessionID);
+
+	//  ó IOCP  (IOCP    κ,  忡  ID  Ŀ   ֵ ID )
+	const uint32_t sessionIOCPIndex = getOwnerWorkerIndex(newSessionID);
+	HANDLE sessionIOCP = mIOCPs[sessionIOCPIndex];
+
+	{
+		newSession->IncrementIoCount();
+
+		newSession->Init(clientSocket, clientAddress, this, newSessionID, newSessionKey, sessionIOCP, headerProfile);
+
+		if (mIoEngine == EIoEngine::Rio)
+		{
+			//   Ŀ Ϸ ť Send, Recv Ϸᰡ ̵ Request Queue 
+			RioCompletionQueue* rioCompletionQueue = &mRioCompletionQueues[sessionIOCPIndex];
+
+			::AcquireSRWLockExclusive(&rioCompletionQueue->Lock);
+			newSession->RioRequestQueue = NetUtils::Rio().RIOCreateRequestQueue(clientSocket, 1, 1, 1, 1, rioCompletionQueue->CQ, rioCompletionQueue->CQ, newSession);
+			::ReleaseSRWLockExclusive(&rioCompletionQueue->Lock);
+
+			ASSERT_LIVE(newSession->RioRequestQueue != RIO_INVALID_RQ, L"RIOCreateRequestQueue() failed");
+		}
+		else
+		{
+			NetUtils::RegisterIOCP(clientSocket, sessionIOCP, reinterpret_cast<ULONG_PTR>(newSession));
+		}
+
+		// accept log
+		//LOGF(ELogLevel::Debug, L"Accept - %s:%d", NetUtils::GetIpAddress(newSession->Address).c_str(), NetUtils::GetPortNumber(newSession->Address));
+
+		// monitoring
+		InterlockedIncrement(&mSessionCount);
+
+		OnAccept(newSession->ID);
+
+		addCounter(&MonitoringCounterBlock::AcceptTPS);
+
+		newSession->PostRecv();
+
+		newSession->DecrementIoCount();
+	}
+}
+
+void NetServer::postAcceptEx(AcceptContext* acceptContext)
+{
+	acceptContext->Socket = NetUtils::CreateSocket(mIoEngine == EIoEngine::Rio);
+	acceptContext->State = AcceptContext::EState::Posted;
+
+	::ZeroMemory(&acceptContext->Overlapped, sizeof(OVERLAPPED));
+
+	DWORD bytes = 0;
+
+	BOOL retAcceptEx = NetUtils::AcceptEx()(mListeners[acceptContext->ListenerIndex].Socket, acceptContext->Socket, acceptContext->AddressBuffer, 0,
+		AcceptContext::ADDRESS_LENGTH, AcceptContext::ADDRESS_LENGTH, &bytes, &acceptContext->Overlapped);
+
+	if (retAcceptEx == FALSE)
+	{
+		int errorCode = ::WSAGetLastError();
+
+		if (errorCode == WSA_IO_PENDING)
+		{
+			return;
+		}
+
+		NetUtils::CloseSocket(acceptContext->Socket);
+		acceptContext->Socket = INVALID_SOCKET;
+
+		//      
+		if (false == mbIsRunning)
+		{
+			return;
+		}
+
+		switch (errorCode)
+		{
+		case WSAECONNRESET:		// ɾ AcceptEx   Ŭ̾Ʈ   
+		case WSAENOBUFS:		// Ͻ ڿ 
+		case WSAEMFILE:
+		{
+			// ٷ ٽ  ʰ IOCP   ļ ٸ Ϸ   óǵ Ѵ (  ߿  尡  ʵ)
+			LOGF(ELogLevel::Debug, L"AcceptEx() failed (errorCode = %d) -> retry", errorCode);
+
+			acceptContext->State = AcceptContext::EState::RetryPost;
+			::PostQueuedCompletionStatus(mIOCPs[0], 0, reinterpret_cast<ULONG_PTR>(this), &acceptContext->Overlapped);
+		}
+		break;
+		default:
+		{
+			LOGF(ELogLevel::Error, L"AcceptEx() failed (errorCode = %d)", errorCode);
+			CrashDump::Crash();
+		}
+		break;
+		}
+	}
+}
+
+void NetServer::handleAcceptCompletion(AcceptContext* acceptContext, const bool bSucceeded, const uint32_t workerIndex)
+{
+	if (acceptContext->State == AcceptContext::EState::RetryPost)
+	{
+		if (mbIsRunning)
+		{
+			postAcceptEx(acceptContext);
+		}
+
+		return;
+	}
+
+	//   ̶ ٽ  ʴ´
+	if (false == mbIsRunning)
+	{
+		NetUtils::CloseSocket(acceptContext->Socket);
+		acceptContext->Socket = INVALID_SOCKET;
+		return;
+	}
+
+	//   Ϸ   IOCPθ ´ -  ȣ   Ŀ ϰ, ٸ Ŀ  Ŀ IOCP Ѱܼ
+	//  , OnAccept, ù PostRecv  Ŀ óϵ Ѵ (IOCP_PER_WORKER  Ŀ Accept  ʵ)
+	if (acceptContext->State == AcceptContext::EState::Posted && bSucceeded)
+	{
+		acceptContext->AcceptedCount = issueAcceptedCount();
+
+		const uint32_t ownerWorkerIndex = getOwnerWorkerIndex(acceptContext->AcceptedCount);
+
+		if (ownerWorkerIndex != workerIndex % mIOCPCount)
+		{
+			acceptContext->State = AcceptContext::EState::HandedOff;
+			::PostQueuedCompletionStatus(mIOCPs[ownerWorkerIndex], 0, reinterpret_cast<ULONG_PTR>(this), &acceptContext->Overlapped);
+			return;
+		}
+	}
+
+	SOCKET clientSocket = acceptContext->Socket;
+	acceptContext->Socket = INVALID_SOCKET;
+
+	const Listener& listener = mListeners[acceptContext->ListenerIndex];
+
+	// Ѱܹ  OVERLAPPED::Internal  AcceptEx Ϸ () ״δ
+	if (bSucceeded)
+	{
+		NetUtils::UpdateAcceptContext(clientSocket, listener.Socket);
+
+		SOCKADDR* localAddress;
+		SOCKADDR* remoteAddress;
+		int localAddressLength;
+		int remoteAddressLength;
+
+		NetUtils::GetAcceptExSockaddrs()(acceptContext->AddressBuffer, 0, AcceptContext::ADDRESS_LENGTH, AcceptContext::ADDRESS_LENGTH,
+			&localAddress, &localAddressLength, &remoteAddress, &remoteAddressLength);
+
+		SOCKADDR_IN clientAddress = *reinterpret_cast<SOCKADDR_IN*>(remoteAddress);
+
+		addCounter(&MonitoringCounterBlock::WorkerAcceptTPS, workerIndex % MonitoringVariables::MAX_WORKER_COUNT);
+
+		setupAcceptedSession(clientSocket, clientAddress, listener.HeaderProfile, acceptContext->AcceptedCount);
+	}
+	else
+	{
+		// Accept ϷǱ  Ŭ̾Ʈ   
+		NetUtils::CloseSocket(clientSocket);
+	}
+
+	postAcceptEx(acceptContext);
+}
+
 Session* NetServer::findSessionOrNull(const uint64_t sessionID) const
 {
 	uint32_t sessionKey = sessionID >> 32;
+	uint32_t segmentIndex = sessionKey >> SESSION_SEGMENT_SIZE_BIT;
 
-	if (sessionKey >= mMaxSessionCount)
+	if (segmentIndex >= MAX_SESSION_SEGMENT_COUNT)
 	{
 		return nullptr;
 	}
 
-	return mSessionList + sessionKey;
+	Session* segment = mSessionSegments[segmentIndex];
+
+	if (segment == nullptr)
+	{
+		return nullptr;
+	}
+
+	return segment + (sessionKey & (SESSION_SEGMENT_SIZE - 1));
+}
+
+bool NetServer::growSessionTable(void)
+{
+	::AcquireSRWLockExclusive(&mSessionTableLock);
+
+	//  ٸ  ٸ 尡 ÷Ȱų,  ݳǾٸ  Ű 
+	if (false == mUnusedSessionKeys.IsEmpty())
+	{
+		::ReleaseSRWLockExclusive(&mSessionTableLock);
+		return true;
+	}
+
+	const bool bIssued = addSessionSegment();
+
+	::ReleaseSRWLockExclusive(&mSessionTableLock);
+
+	return bIssued;
+}
+
+bool NetServer::addSessionSegment(void)
+{
+	//  ׸Ʈ  ߱ߴٸ  ׸Ʈ 
+	if (mSessionKeyCount == mSessionSegmentCount * SESSION_SEGMENT_SIZE && mSessionKeyCount < mMaxSessionCount)
+	{
+		const uint32_t segmentIndex = mSessionSegmentCount;
+		Session* segment = new Session[SESSION_SEGMENT_SIZE];
+
+		for (uint32_t i = 0; i < SESSION_SEGMENT_SIZE; ++i)
+		{
+			Session* session = &segment[i];
+
+			session->bDisconnected = true;
+			session->PendingCopyPacket = nullptr;
+			session->CopySendBuffer = ((mbIsProtocolV2 || mbIsMultiMessageFrame) && mIoEngine != EIoEngine::Rio) ? new char[Session::COPY_SEND_BUFFER_SIZE] : nullptr;
+			session->RegisteredPacketCount = 0;
+			session->RegisteredPacketCapacity = Session::INITIAL_REGISTERED_PACKET_CAPACITY;
+			session->RegisteredPackets = new Serializer*[Session::INITIAL_REGISTERED_PACKET_CAPACITY];
+			session->initRecvBuffer(mbIsPooledRecvBuffer);
+
+			if (mIoEngine == EIoEngine::Rio)
+			{
+				::InitializeSRWLock(&session->RioLock);
+
+				session->RioRecvBufferID = NetUtils::Rio().RIORegisterBuffer(session->RecvBuffer.GetBufferPtr(), session->RecvBuffer.GetMappedSize());
+				ASSERT_LIVE(session->RioRecvBufferID != RIO_INVALID_BUFFERID, L"RIO recv buffer RIORegisterBuffer() failed");
+
+				// ִ   Ѵ  Ű ߱ Ƿ ۽ ۸  ʴ´
+				session->RioSendOffset = ((segmentIndex << SESSION_SEGMENT_SIZE_BIT) + i) * Session::RIO_SEND_BUFFER_SIZE;
+				session->RioSendBuffer = mRioSendBuffer + session->RioSendOffset;
+			}
+		}
+
+		// ׸Ʈ ͸   ڿ Ű ߱ؾ findSessionOrNull() ׻ ׸Ʈ ã  ִ
+		InterlockedExchangePointer(reinterpret_cast<PVOID*>(&mSessionSegments[segmentIndex]), segment);
+		mSessionSegmentCount++;
+
+		LOGF(ELogLevel::System, L"Session table grown (segment count = %u, capacity = %u)", mSessionSegmentCount, mSessionSegmentCount * SESSION_SEGMENT_SIZE);
+	}
+
+	// Ҵ ׸Ʈ  ִ    Ű ߱
+	uint32_t keyEnd = mSessionSegmentCount * SESSION_SEGMENT_SIZE;
+
+	if (keyEnd > mMaxSessionCount)
+	{
+		keyEnd = mMaxSessionCount;
+	}
+
+	const bool bIssued = mSessionKeyCount < keyEnd;
+
+	for (; mSessionKeyCount < keyEnd; ++mSessionKeyCount)
+	{
+		mUnusedSessionKeys.Push(mSessionKeyCount);
+	}
+
+	return bIssued;
+}
+
+bool NetServer::RaiseMaxSessionCount(const uint32_t maxSessionCount)
+{
+	if (mIoEngine == EIoEngine::Rio || maxSessionCount > MAX_SESSION_TABLE_CAPACITY)
+	{
+		return false;
+	}
+
+	::AcquireSRWLockExclusive(&mSessionTableLock);
+
+	const bool bRaised = maxSessionCount > mMaxSessionCount;
+
+	if (bRaised)
+	{
+		mMaxSessionCount = maxSessionCount;
+	}
+
+	::ReleaseSRWLockExclusive(&mSessionTableLock);
+
+	if (bRaised)
+	{
+		LOGF(ELogLevel::System, L"Max session count raised (%u)", maxSessionCount);
+	}
+
+	return bRaised;
 }
\ No newline at end of file
@@ -1,22 +1,95 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <queue>
+#include <functional>
 
 #include "Serializer.h"
 #include "../DataStructure/LockFreeStack.h"
 
 class Session;
+struct RioCompletionQueue;
+struct AcceptContext;
+struct WorkerInbox;
+struct RecvBufferBlock;
 typedef void* HANDLE;
 typedef unsigned long long SOCKET;
+typedef struct RIO_BUFFERID_t* RIO_BUFFERID;
+
+// Ʈũ I/O 
+enum class EIoEngine
+{
+    Iocp,   // WSARecv/WSASend + IOCP Ϸ 
+    Rio     // Registered I/O (̸  ۷ ۼ, Ϸ ť Ŀ  ϰ ó)
+};
+
+// ۽ ť    ( Ŭ̾Ʈ)  ó å
+enum class ESlowConsumerPolicy
+{
+    Disconnect, //  ´
+    DropOldest, // ۽ ť   droppable Ŷ(Serializer::SetDroppable)   Ŷ ִ´ ( 忡 ť ǵ帲)
+                //  Ŷ ٸ ( 尡 ƴ϶ ׻)  Ŷ droppable   Ŷ , ƴ϶  ´
+    DropNew     //  Ŷ droppable̶ , ƴ϶  ´
+};
+
+//  ӵ   Ŷ  ó å
+enum class ERecvRateLimitPolicy
+{
+    Drop,       // OnReceive ȣ ʰ 
+    Disconnect  //  ´
+};
 
 /************************** monitoring variables **************************/
+
+//   ϴ ī  - ī͸ ߰  ⿡  ٸ ߰ϸ ȴ
+// (MonitoringVariables ʵ, 庰 ī , monitorThread 谡    )
+#define NET_SERVER_TPS_COUNTER_LIST(X) \
+    X(AcceptTPS)                    /* ʴ  ó Ƚ (OnAccept  Ƚ) */ \
+    X(RecvMessageTPS)               /* ʴ ޼ ó Ƚ (OnReceive  Ƚ) */ \
+    X(SendMessageTPS)               /* ʴ ޼ ۽ Ƚ */ \
+    X(RecvPendingTPS)               /* ʴ WSARecv IO_PENDING Ƚ */ \
+    X(SendPendingTPS)               /* ʴ WSASend IO_PENDING Ƚ */ \
+    X(SendFlushTPS)                 /* ʴ ۽ Ϸ Ƚ (SendMessageTPS / SendFlushTPS = ۽ 1ȸ Ŷ ) */ \
+    X(LingerFlushTPS)               /* ʴ ۽ (linger) ð   ۽ Ƚ */ \
+    X(DroppedSendPacketTPS)         /* ʴ ۽ ť  ʰ  Ŷ  (DropOldest, DropNew å) */ \
+    X(SlowConsumerDisconnectTPS)    /* ʴ ۽ ť  ʰ    (Disconnect å,    Ŷ  DropOldest, DropNew å) */ \
+    X(RetainedViewCopyTPS)          /* ʴ OnReceive Ŀ   ־ ü ۷  Zero-copy Ŷ  */ \
+    X(ThrottledRecvPacketTPS)       /* ʴ  ӵ   Ŷ  (Drop å) */ \
+    X(RateLimitDisconnectTPS)       /* ʴ  ӵ     (Disconnect å) */ \
+    X(MultiMessageFrameTPS)         /* ʴ ۽ Ƽ ޽   */ \
+    X(MultiMessageFramePacketTPS)   /* ʴ Ƽ ޽ ӿ  Ŷ  */ \
+    X(MultiMessageFrameBytesTPS)    /* ʴ Ƽ ޽  ۽ Ʈ */ \
+    X(MultiMessageFrameUnframedBytesTPS) /*  Ŷ   ´ٸ ۽ Ʈ (Bytes  =   Ʈ) */ \
+    X(CompressTPS)                  /* ʴ  õ Ŷ  (Ŷ  ,   ) */ \
+    X(CompressInputBytesTPS)        /* ʴ   ̷ε Ʈ */ \
+    X(CompressOutputBytesTPS)       /* ʴ   ̷ε Ʈ (پ ʾ ״  Ŷ  ũ, Output / Input = ) */ \
+    X(CompressTicksTPS)             /* ʴ ࿡  ð (QueryPerformanceCounter ) */ \
+    X(CompressedSendTPS)            /* ʴ ົ ٲ㼭 ۽ ť  Ƚ ( ) */
+
+//    ī  (̸,  )
+#define NET_SERVER_TPS_HISTOGRAM_LIST(X) \
+    X(WorkerAcceptTPS, MonitoringVariables::MAX_WORKER_COUNT)                           /* Ŀ ʴ Accept ó Ƚ (AcceptOnWorkers ɼ) */ \
+    X(PacketsPerSendHistogram, MonitoringVariables::PACKETS_PER_SEND_BUCKET_COUNT)      /* ʴ ۽ Ϸ Ƚ Ŷ   ([i] = 2^i ~ 2^(i+1)-1) */ \
+    X(CompletionsPerWakeupHistogram, MonitoringVariables::COMPLETIONS_PER_WAKEUP_BUCKET_COUNT) /* ʴ Ŀ  Ƚ  Ϸ    ([i] = 2^i ~ 2^(i+1)-1) */
+
 struct MonitoringVariables
 {
-    uint32_t AcceptTPS;                 // ʴ  ó Ƚ (OnAccept  Ƚ)
-    uint32_t RecvMessageTPS;            // ʴ ޼ ó Ƚ (OnReceive  Ƚ)
-    uint32_t SendMessageTPS;            // ʴ ޼ ۽ Ƚ
-    uint32_t RecvPendingTPS;
-    uint32_t SendPendingTPS;
+    enum
+    {
+        MAX_WORKER_COUNT = 32,                  // Ŀ 踦  ϴ ִ Ŀ  (Ѿ   ջ)
+        PACKETS_PER_SEND_BUCKET_COUNT = 11,     // ۽ 1ȸ Ŷ  ׷   (1 ~ 1024)
+        COMPLETIONS_PER_WAKEUP_BUCKET_COUNT = 9 // Ŀ    Ϸ   ׷   (1 ~ 256)
+    };
+
+#define X(name) uint32_t name;
+    NET_SERVER_TPS_COUNTER_LIST(X)
+#undef X
+#define X(name, count) uint32_t name[count];
+    NET_SERVER_TPS_HISTOGRAM_LIST(X)
+#undef X
+    uint32_t RecvBufferPoolCapacity;    //   Ǯ ݱ    (  Ǯ )
+    uint32_t RecvBufferPoolUseCount;    //        (  Ǯ )
     uint32_t AverageAcceptTPS;
     uint32_t AverageRecvMessageTPS;
     uint32_t AverageSendMessageTPS;
@@ -29,6 +102,18 @@ struct MonitoringVariables
     float ProcessorTimeKernel;
     float ProcessTimeKernel;
 };
+
+//  ϳ ϴ ī  (ٸ  ĳ   ʵ )
+//  常 Interlocked  ϰ (ʱȭ X), monitorThread     հ ؼ ʴ  Ѵ
+struct alignas(64) MonitoringCounterBlock
+{
+#define X(name) uint32_t name;
+    NET_SERVER_TPS_COUNTER_LIST(X)
+#undef X
+#define X(name, count) uint32_t name[count];
+    NET_SERVER_TPS_HISTOGRAM_LIST(X)
+#undef X
+};
 /************************** monitoring variables **************************/
 
 class NetServer
@@ -51,10 +136,105 @@ public: // 
     // SND_BUF = 0 ɼ 
     inline void SetSendBufferSizeToZero(bool bToSet) { mbIsSendBufferSizeZero = bToSet; }
 
+    // ۽ 1ȸ  Ʈ  ( ũ⸦ ѱ  Ŷ  ۽ ѱ, 0̸ ⺻ 64KB)
+    inline void SetSendGatherByteBudget(const uint32_t bytes) { mSendGatherByteBudget = bytes; }
+
+    // ۽ (linger) - Ŀ 忡  Ŷ ִ microseconds  SendQueue Ҵٰ 
+    // ť  ũⰡ bytes ̻ Ǹ ٷ  (microseconds 0̸   , bytes 0̸ SendGatherByteBudget)
+    inline void SetSendLinger(const uint32_t microseconds, const uint32_t bytes) { mSendLingerMicroseconds = microseconds; mSendLingerBytes = bytes; }
+
+    // ۽ ť   -  ۽ ť  (Ʈ Ǵ Ŷ )  policy ϰ,   Ϸ   Ѵ
+    //   0    (  0̸  ), SendAndDisconnect()  Ŷ  ʴ´
+    inline void SetSendBackpressure(const ESlowConsumerPolicy policy, const uint32_t highBytes, const uint32_t lowBytes, const uint32_t highPackets, const uint32_t lowPackets)
+    {
+        mSlowConsumerPolicy = policy;
+        mSendHighWatermarkBytes = highBytes;
+        mSendLowWatermarkBytes = lowBytes;
+        mSendHighWatermarkPackets = highPackets;
+        mSendLowWatermarkPackets = lowPackets;
+    }
+
+    // Zero-copy  -  ۿ   Ŷ  ʰ  ۸ ״ ٶ󺸴 б  Ŷ OnReceive 
+    //  OnReceive ϱ  Ŷ ϴ   (OnReceive ı  ִ Ŷ ü ۷ , RetainedViewCopyTPS )
+    // ٸ  ѱٸ   OnReceive  ڿ о Ѵ ( ߿ View   )
+    // , OnReceive ȿ GetBytePointer()  ʹ 纻  Ƿ OnReceive Ŀ   ȴ
+    inline void SetZeroCopyReceive(bool bToSet) { mbIsZeroCopyReceive = bToSet; }
+
+    //   Ǯ -   ۸  ʰ, Ͱ    Ǯ    ݳѴ
+    //    0Ʈ WSARecv ɾιǷ    ޸𸮸 Ƴ (RIO , MirroredRingBufferʹ Բ   )
+    inline void SetPooledRecvBuffer(bool bToSet) { mbIsPooledRecvBuffer = bToSet; }
+
+    //  v2 -   hello  Ŭ̾Ʈ  Ű ϰ,   Ʈ Ʈ ü ChaCha20 ȣȭѴ
+    // hello  ٷ v1 Ŷ  Ŭ̾Ʈ  Ʈ ״ v1 óѴ (NET  )
+    // key  v2 Ŭ̾Ʈ ̸   PROTOCOL_V2_KEY_SIZEƮ  Ű,  ù   ۽ ȴ
+    //   : Ű 𸣴  ڿ Ʈ   ̴
+    //  -  Ű   Ű    nonceθ Ƿ, Ŭ̾Ʈ 忡 Ű   ٸ     ִ (Ű ȯ,   )
+    //  - MAC  8Ʈ üũ Ƿ ȣ Ʈ  ٲġϴ   Ѵ (Ἲ,   )
+    inline void SetProtocolV2Key(const uint8_t key[])
+    {
+        memcpy(mProtocolV2Key, key, PROTOCOL_V2_KEY_SIZE);
+        mbIsProtocolV2 = true;
+    }
+
+    // Ƽ ޽   - SetSessionMultiMessageFrame()   ۽  ۽ ť Ŷ  ϳ ´
+    //  NETWORK_HEADER_CODE_MULTI_MESSAGE  ϳ ڿ [uint16_t ][̷ε] ̰̾ ڵ, üũ   Ѵ (NET  )
+    //  Ʈ Ŭ̾Ʈ ڵ Ƚ پ   Ǹ ̷ε带 Ѵ (Ŷ ۸ ״  )
+    inline void SetMultiMessageFrame(bool bToSet) { mbIsMultiMessageFrame = bToSet; }
+
+    // ̷ε   - SetSessionCompression()  ǿ thresholdBytes ̻ Ŷ LZ4  ؼ  (0̸   , NET  )
+    //  Ŷ NETWORK_HEADER_CODE_COMPRESSED  ڿ [uint16_t  ][LZ4 ], ص پ ʴ Ŷ ״ 
+    //  Ŷ   ϰ ົ  Ŷ Ŵ޾ ιǷ εĳƮ ڵ  ົ  īƮ Ѵ
+    inline void SetCompression(const uint32_t thresholdBytes) { mCompressionThreshold = thresholdBytes; }
+
+    //  ӵ  - Ǹ ʴ Ŷ , ʴ Ʈ  ū Ŷ Ѵ (ִ 1 з Ƽ   , 0̸  )
+    // Ʈ Ŷ ּ ִ ũ Ŷ( + SetMaxPayloadLength) 1   ְ Ƿ bytesPerSecond ū Ŷ Ŷ  ޴´
+    //   Ŷ OnReceive  policy  ó
+    inline void SetRecvRateLimit(const ERecvRateLimitPolicy policy, const uint32_t packetsPerSecond, const uint32_t bytesPerSecond)
+    {
+        mRecvRateLimitPolicy = policy;
+        mRecvPacketsPerSecond = packetsPerSecond;
+        mRecvBytesPerSecond = bytesPerSecond;
+    }
+
+    // Ŷ ŸԺ ʴ Ŷ   (̷ε   2Ʈ Ŷ Ÿ ),  Ÿ  ⺻ Ŷ      
+    // ִ MAX_RECV_RATE_LIMIT_TYPE_COUNT  ,    ȣ 
+    bool AddRecvRateLimitForPacketType(const uint16_t packetType, const uint32_t packetsPerSecond);
+
     // ޼ ִ  (ִ ̸ Ѿ ޼    ´)
     inline void SetMaxPayloadLength(const uint16_t length) { mMaxPayloadLength = length; }
 
-    //  
+    // Ŀ 帶  IOCP д (Ŀ 1 = ̺Ʈ  1)
+    //  Accept  ϳ IOCP Ǹ, ش  Ϸ  ׻  Ŀ óѴ
+    inline void SetIocpPerWorker(bool bToSet) { mbIsIocpPerWorker = bToSet; }
+
+    //  I/O   (⺻ IOCP)
+    // RIO ϸ Ŀ 帶 RIO Ϸ ť ϳ ιǷ IocpPerWorker ɼ  
+    inline void SetIoEngine(const EIoEngine ioEngine) { mIoEngine = ioEngine; }
+
+    // Accept    Ŀ  AcceptEx ̸ ɾΰ ڽ ̺Ʈ  Accept óѴ
+    // Ŀ ACCEPT_EX_COUNT_PER_WORKER AcceptEx ϸ, ϷḦ ó Ŀ ٽ AcceptEx Ǵ
+    inline void SetAcceptOnWorkers(bool bToSet) { mbIsAcceptOnWorkers = bToSet; }
+
+    //   -   Ŀ 常 ش  ۽ ť ٷ (IocpPerWorker ɼ  )
+    // ٸ 忡 SendPacket  Ŀ Inbox ޵ǰ,  Ŀ SendPacket Interlocked  óȴ
+    inline void SetSharded(bool bToSet) { mbIsSharded = bToSet; }
+
+    // Ŀ 带 ھ ϳ  (Ŀ ε %  μ )
+    inline void SetWorkerAffinity(bool bToSet) { mbIsWorkerAffinity = bToSet; }
+
+    // Ŀ GetQueuedCompletionStatusEx    ִ Ϸ   (1 ~ MAX_COMPLETION_BATCH_SIZE, 0̸ ⺻ 64)
+    // Ŭ Ŀ ȯ   Ŀ  Ƽ Ƿ ٸ Ŀ  л ĥ
+    inline void SetCompletionBatchSize(const uint32_t batchSize) { mCompletionBatchSize = batchSize; }
+
+    //  ۽ - Ŀ 忡 SendPacket Enqueue ϰ, Ŀ  GQCS ȣϱ  Ǵ   PostSendѴ
+    //    ǿ  Ŷ  ϳ WSASend δ (Ŀ 尡 ƴ  SendPacket  ۽)
+    inline void SetDeferredFlush(bool bToSet) { mbIsDeferredFlush = bToSet; }
+
+    //  ߰ - port   headerProfile  ۼѴ (   ȣ, Start() ʸ ؼ ִ MAX_LISTENER_COUNT)
+    //  ŷ (ٸ  ) LAN  θ ڵ, üũ  óѴ
+    bool AddListener(const uint16_t port, const ENetworkHeaderProfile headerProfile);
+
+    //   (port ⺻  (NETWORK_HEADER_USE_TYPE) )
     virtual void Start(
         const uint16_t port,
         const uint32_t maxSessionCount,
@@ -64,17 +244,37 @@ public: // 
     //   ( 尡    )
     virtual void Shutdown(void);
 
+    //  ߿ ִ   ø (  , MAX_SESSION_TABLE_CAPACITY)
+    //  ̺   ׸Ʈ  þǷ ̸ ޸𸮸  ʴ´ (RIO     ҴϹǷ  Ұ)
+    bool RaiseMaxSessionCount(const uint32_t maxSessionCount);
+
 public: //   Լ
 
     // Ŷ  û - SendQueue Enqueue
     void SendPacket(const uint64_t sessionID, Serializer* packet);
 
+    //  Ŷ  ǿ  û -  ۽ ť ( 忡  Ŀ ѱ)   ȯ
+    //  īƮ   ø   ǵ, ̹   IoCount   ɷ
+    //  忡  Ŀ Inbox  ְ Ŀ   
+    uint32_t SendPacketMulti(const uint64_t sessionIDs[], const size_t count, Serializer* packet);
+
     //   û
     void Disconnect(const uint64_t sessionID);
 
     // Ŷ    û
     void SendAndDisconnect(const uint64_t sessionID, Serializer* packet);
 
+    // Ǻ ۽ (linger)  (  , SetSendLinger() )
+    void SetSessionSendLinger(const uint64_t sessionID, const uint32_t microseconds, const uint32_t bytes);
+
+    //  ۽ Ƽ ޽  ٲ۴ ( Ŭ̾Ʈ   ȣ,  ۽ź ,   )
+    // ɼ  ְų LAN  ̶ false
+    bool SetSessionMultiMessageFrame(const uint64_t sessionID);
+
+    //  ۽ſ ̷ε  Ҵ ( Ŭ̾Ʈ   ȣ,  ۽ ť ִ Ŷ ,   )
+    // ɼ  ְų LAN  ̶ false
+    bool SetSessionCompression(const uint64_t sessionID);
+
     //  ּҸ ´
     bool GetSessionAddress(const uint64_t sessionID, SOCKADDR_IN* outAddress) const;
 
@@ -83,13 +283,42 @@ public: // Getters
     inline static std::wstring	GetServerVersion(void) { return L"6.7.0"; }
 
     inline bool					IsRunning(void) const { return mbIsRunning; }
+    inline bool					IsIocpPerWorker(void) const { return mbIsIocpPerWorker; }
+    inline EIoEngine			GetIoEngine(void) const { return mIoEngine; }
+    inline bool					IsAcceptOnWorkers(void) const { return mbIsAcceptOnWorkers; }
+    inline bool					IsSharded(void) const { return mbIsSharded; }
+    inline bool					IsDeferredFlush(void) const { return mbIsDeferredFlush; }
+    inline bool					IsPooledRecvBuffer(void) const { return mbIsPooledRecvBuffer; }
+    inline bool					IsZeroCopyReceive(void) const { return mbIsZeroCopyReceive; }
+    inline bool					IsMultiMessageFrame(void) const { return mbIsMultiMessageFrame; }
+    inline uint32_t				GetCompressionThreshold(void) const { return mCompressionThreshold; }
+    inline uint32_t				GetCompletionBatchSize(void) const { return mCompletionBatchSize; }
+    inline uint32_t				GetWorkerThreadCount(void) const { return mThreadCount - 2; }
     inline uint16_t				GetPortNumber(void) const { return mPort; }
+    inline uint32_t				GetListenerCount(void) const { return mListenerCount; }
     inline uint16_t				GetMaxPayloadLength(void) const { return mMaxPayloadLength; }
     inline uint64_t				GetTotalAcceptCount(void) const { return mSessionAcceptedCount; }
     inline uint64_t				GetTotalDisconnectCount(void) const { return mSessionDisconnectedCount; }
     inline MonitoringVariables	GetMonitoringInfo(void) const { return mMonitorResult; }
     inline uint32_t				GetSessionCount(void) const { return mSessionCount; }
     inline uint32_t				GetMaxSessionCount(void) const { return mMaxSessionCount; }
+    inline uint32_t				GetAllocatedSessionCount(void) const { return mSessionSegmentCount * SESSION_SEGMENT_SIZE; }
+
+public:
+
+    enum
+    {
+        SESSION_SEGMENT_SIZE_BIT = 10,
+        SESSION_SEGMENT_SIZE = 1 << SESSION_SEGMENT_SIZE_BIT,   //  ̺ ׸Ʈ ϳ  
+        MAX_SESSION_SEGMENT_COUNT = 256,                        // ׸Ʈ  ̺ ũ (̸ ƵιǷ ȸ  ȭ X)
+        MAX_SESSION_TABLE_CAPACITY = SESSION_SEGMENT_SIZE * MAX_SESSION_SEGMENT_COUNT,
+        MAX_LISTENER_COUNT = 4,                                 // ִ   (Start()  )
+        MAX_RECV_RATE_LIMIT_TYPE_COUNT = 8,                     //  ӵ   δ Ŷ Ÿ ִ 
+        MAX_RECV_BATCH_SIZE = 64,                               // OnReceiveBatch   ѱ ִ Ŷ 
+        MAX_COMPLETION_BATCH_SIZE = 256,                        // Ŀ    ִ Ϸ  
+        PROTOCOL_V2_KEY_SIZE = 32,                              //  v2  Ű ũ
+        PROTOCOL_V2_NONCE_SIZE = 8                              //  v2 hello nonce ũ
+    };
 
 public: //  ڵ鷯  Լ
 
@@ -101,39 +330,229 @@ public: // 
     // ޵ Ŷ   ־ մϴ.
     virtual void OnReceive(const uint64_t sessionID, Serializer* packet) = 0;
 
+    //  Ϸ     Ŷ   ϼǾ  OnReceive  ȣ˴ϴ. (ִ MAX_RECV_BATCH_SIZE,  )
+    //  ȸ,   Ŷ  ʰ   óϰ ʹٸ ϼ. (⺻  Ŷ OnReceive ȣ)
+    // ޵ Ŷ    ־ մϴ.
+    virtual void OnReceiveBatch(const uint64_t sessionID, Serializer* const packets[], const uint32_t packetCount)
+    {
+        for (uint32_t i = 0; i < packetCount; ++i)
+        {
+            OnReceive(sessionID, packets[i]);
+        }
+    }
+
     //    ȣ
     //  Լ ȣǸ  ̻ ش ID ȿ ʽϴ.
     virtual void OnRelease(const uint64_t sessionID) = 0;
 
 private: //  Լ
 
-    static unsigned int acceptThread(void* netServerParam);     // Accept,   
+    static unsigned int acceptThread(void* listenerParam);      // Accept,    (ʸ 1)
     static unsigned int iocpWorkerThread(void* netServerParam); // IOCP ̺Ʈ ó
     static unsigned int monitorThread(void* netServerParam);    // ͸  
 
+private: // Ϸ  ó
+
+    // ۽ Ϸ ó (ߴ Ŷ    ۽)
+    void handleSendCompletion(Session* session);
+
+    //  Ϸ ó -   Ϸ Ưȭ   ȣѴ ( б Ϸ  1ȸ  )
+    void handleRecvCompletion(Session* session, const uint32_t transferredBytes);
+
+    //  Ϸ ó (Ŷ   OnReceive ȣ,  ), Ŷ   Ϻ ϵǹǷ  бⰡ 
+    //   ϴ Ȳ̶    ʰ Ѵ
+    template <ENetworkHeaderProfile PROFILE>
+    void processRecvCompletion(Session* session, const uint32_t transferredBytes);
+
+    //    Ŷ   (1 OnReceive,   OnReceiveBatch), Zero-copy Ŷ    ۿ и
+    void dispatchReceivedPackets(Session* session, Serializer* const packets[], const uint32_t packetCount);
+
+    // RIO Ϸ ť  Ϸ  ϰ  óϰ,   ûѴ (RIONotify)
+    void processRioCompletions(RioCompletionQueue* rioCompletionQueue);
+
+    // AcceptEx Ϸ ó (    AcceptContext ٽ AcceptEx Ǵ)
+    //   Ŀ ƴ϶ PostQueuedCompletionStatus  Ŀ ѱ, Ͻ   ߴ AcceptEx ٽ Ǵ
+    void handleAcceptCompletion(AcceptContext* acceptContext, const bool bSucceeded, const uint32_t workerIndex);
+
+    // ۽ û -  ۽  dirty Ʈ , ƴ϶ ٷ PostSend (ȣ  IoCount   )
+    void requestSend(Session* session);
+
+    // dirty Ʈ ǵ PostSend (Ŀ 忡 GQCS ȣ  ȣ)
+    void flushDirtySessions(void);
+
+    // ۽  ð  ǵ PostSend,    ð(ms)  (GQCS ŸӾƿ )
+    uint32_t flushExpiredLingerSessions(void);
+
+    // Inbox  ۽ û ó ( ,  Ŀ 忡 ȣ)
+    void drainInbox(WorkerInbox* inbox);
+
+private: //  
+
+    //   Ŀ ε ( ID  32Ʈ ǹǷ  ü  ʾƵ   )
+    inline uint32_t getOwnerWorkerIndex(const uint64_t sessionID) const { return static_cast<uint32_t>(sessionID) % mIOCPCount; }
+
+    //  Ŀ ٷ ó, ƴ϶  Ŀ Inbox  (Ŷ  īƮ ȣ  ÷ )
+    void routeSendPacket(const uint64_t sessionID, Serializer* packet, const bool bDisconnectAfterSend);
+
+    //  Ŀ 忡 ۽ ó (Ŷ  īƮ ȣ  ÷ ), ۽ ť ־ٸ true
+    bool sendPacketOnOwner(const uint64_t sessionID, Serializer* packet, const bool bDisconnectAfterSend);
+
+    // ۽ ť  Ȯϰ å Ѵ, packet ť ־ ȴٸ true ( IoCount ִ )
+    bool admitSendPacket(Session* session, const Serializer* packet);
+
+    // Ǻ ϴ ۽  Ҵ (NET  Ǹ),  ã ߴٸ false
+    bool enableSessionSendFeature(const uint64_t sessionID, bool Session::* feature);
+
+    // Ŷ(NET  ۽ غ ) ົ ´, ó û 尡  Ŷ Ŵ޾ д
+    // ص پ ʴ Ŷ̶ nullptr ( īƮ ø Ƿ ȣڰ ø )
+    Serializer* getCompressedPacket(Serializer* packet);
+
+    //     ù  ͸  v1, v2 Ѵ (v2  Ű ϰ  hello ۽)
+    // ߸ hello false, Ǵ ŭ  ߴٸ   ״ Undecided
+    bool handshakeProtocol(Session* session);
+
+    //  ӵ  ū  ðŭ ä ( Ϸ 1ȸ 1)
+    void refillRecvTokens(Session* session);
+
+    // ڵ Ŷ ϳŭ ū ҸѴ, ū ϴٸ Ҹ ʰ false
+    bool consumeRecvTokens(Session* session, const Serializer* packet);
+
 private: //  ƿ Լ
 
     //  ID   ü ´
     Session* findSessionOrNull(const uint64_t sessionID) const;
 
+    //    Ű   ȣ, ִ   ȿ ׸Ʈ ϳ ߰ϰ   Ű ߱Ѵ
+    // ٸ 尡  ÷Ȱų Ű ߱ߴٸ true,  ̻ ø  ٸ false
+    bool growSessionTable(void);
+
+    // ʿϴٸ ׸Ʈ ϳ ߰ϰ ִ      Ű ߱Ѵ, ߱ Ű ִٸ true (mSessionTableLock  ¿ ȣ)
+    bool addSessionSegment(void);
+
+    // Accept   ϰ  Recv Ǵ (acceptThread, AcceptEx Ϸ ó )
+    // acceptedCount issueAcceptedCount()   ȣ,  ID  Ŀ  ȣ 
+    void setupAcceptedSession(const SOCKET clientSocket, const SOCKADDR_IN& clientAddress, const ENetworkHeaderProfile headerProfile, const uint64_t acceptedCount);
+
+    //   ȣ ޴´ ( ID  32Ʈ,  Ŀ  ȣ )
+    inline uint64_t issueAcceptedCount(void) { return InterlockedIncrement64(reinterpret_cast<LONG64*>(&mSessionAcceptedCount)); }
+
+    // AcceptContext    AcceptEx Ǵ
+    void postAcceptEx(AcceptContext* acceptContext);
+
+    // ͸ ī  - ī    ڱ Ͽ Ϲ ,     Ͽ Interlocked
+    inline void addCounter(uint32_t MonitoringCounterBlock::* counter, const uint32_t value = 1)
+    {
+        if (l_counterBlock != nullptr)
+        {
+            l_counterBlock->*counter += value;
+        }
+        else
+        {
+            InterlockedAdd(reinterpret_cast<volatile LONG*>(&(mCounterBlocks[mCounterBlockCount - 1].*counter)), static_cast<LONG>(value));
+        }
+    }
+
+    template <size_t BucketCount>
+    inline void addCounter(uint32_t (MonitoringCounterBlock::* counter)[BucketCount], const uint32_t bucket, const uint32_t value = 1)
+    {
+        if (l_counterBlock != nullptr)
+        {
+            (l_counterBlock->*counter)[bucket] += value;
+        }
+        else
+        {
+            InterlockedAdd(reinterpret_cast<volatile LONG*>(&(mCounterBlocks[mCounterBlockCount - 1].*counter)[bucket]), static_cast<LONG>(value));
+        }
+    }
+
 private:
 
     bool				    mbIsRunning;				//  
     bool				    mbIsTcpNodelay;				// ɼ - TCP_NODELAY ϴ°
     bool				    mbIsSendBufferSizeZero;		// ɼ - SND_BUF  0
-    HANDLE				    mIOCP;						// IOCP ڵ
-    SOCKET				    mListenSocket;				//  
-    uint16_t			    mPort;						// Ʈ ȣ
+    bool				    mbIsIocpPerWorker;			// ɼ - Ŀ 帶 IOCP  
+    HANDLE*				    mIOCPs;						// IOCP ڵ ( IOCP 1 Ǵ Ŀ ŭ)
+    uint32_t			    mIOCPCount;					// IOCP ڵ 
+    uint32_t			    mWorkerIndexCounter;		// Ŀ 尡 ڽ ε   ī
+    EIoEngine			    mIoEngine;					// ɼ - I/O 
+    RioCompletionQueue*	    mRioCompletionQueues;		// RIO Ϸ ť (IOCP ŭ)
+    char*				    mRioSendBuffer;				// RIO ۽ſ   (Ǹ RIO_SEND_BUFFER_SIZE  )
+    RIO_BUFFERID		    mRioSendBufferID;			// mRioSendBuffer RIO  ID
+    bool				    mbIsAcceptOnWorkers;		// ɼ - Ŀ 忡 AcceptEx Accept ó
+    AcceptContext*		    mAcceptContexts;			// AcceptEx ؽƮ (Ŀ  * ACCEPT_EX_COUNT_PER_WORKER)
+    uint32_t			    mAcceptContextCount;		// mAcceptContexts 
+    bool				    mbIsSharded;				// ɼ -  
+    bool				    mbIsWorkerAffinity;			// ɼ - Ŀ  ھ 
+    uint32_t			    mCompletionBatchSize;		// ɼ - Ŀ    ִ Ϸ  
+    WorkerInbox*		    mInboxes;					// Ŀ Inbox ( , IOCP ŭ)
+    bool				    mbIsDeferredFlush;			// ɼ -  ۽
+    bool				    mbIsZeroCopyReceive;		// ɼ - Zero-copy 
+    bool				    mbIsPooledRecvBuffer;		// ɼ -   Ǯ
+    LockFreeObjectPool<RecvBufferBlock>* mRecvBufferPool;	//   Ǯ (  Ǯ )
+
+    inline static thread_local uint32_t	l_workerIndex = UINT32_MAX;		//   Ŀ ε (Ŀ 尡 ƴ϶ UINT32_MAX)
+    inline static thread_local Session*	l_processingSession = nullptr;	//  尡 Ϸ  ó   (  IoCount ̹ )
+    inline static thread_local MonitoringCounterBlock* l_counterBlock = nullptr;	//  尡  ī  (Ŀ, Accept 常 )
+    inline static thread_local std::vector<Session*> l_dirtySessions;	//  ۽   ǵ (Ŀ 庰)
+    inline static thread_local std::vector<uint32_t> l_multicastInboxes;	// SendPacketMulti() Ŷ  Inbox Ŀ ε ( )
+
+    // ۽ (linger) Ÿ̸
+    struct LingerTimer
+    {
+        uint64_t	ExpireMicroseconds;
+        Session*	LingerSession;
+
+        inline bool operator>(const LingerTimer& other) const { return ExpireMicroseconds > other.ExpireMicroseconds; }
+    };
+
+    inline static thread_local std::priority_queue<LingerTimer, std::vector<LingerTimer>, std::greater<LingerTimer>> l_lingerTimers; // Ŀ 庰 Ÿ̸ ( ð  )
+
+    //  (Ʈ    д)
+    struct Listener
+    {
+        NetServer*              Server;
+        SOCKET                  Socket;                 //  
+        uint16_t                Port;
+        ENetworkHeaderProfile   HeaderProfile;          //  ʷ    
+        HANDLE                  AcceptThread;           // Accept   (Ŀ  Accept  nullptr)
+    };
+
+    Listener			    mListeners[MAX_LISTENER_COUNT];	// ʵ (AddListener() ߰ , Start()  )
+    uint32_t			    mListenerCount;				//  
+    uint16_t			    mPort;						// Ʈ ȣ (Start() )
     uint16_t			    mMaxPayloadLength;			// ̷ε ִ  (Header.Length)
+    uint32_t			    mSendGatherByteBudget;		// ۽ 1ȸ  Ʈ 
+    uint32_t			    mSendLingerMicroseconds;	// ۽  ð ( ⺻)
+    uint32_t			    mSendLingerBytes;			// ۽  Ʈ ( ⺻)
+    ESlowConsumerPolicy	    mSlowConsumerPolicy;		// ۽ ť  ʰ  å
+    uint32_t			    mSendHighWatermarkBytes;	// ۽ ť   (Ʈ)
+    uint32_t			    mSendLowWatermarkBytes;		// ۽ ť   (Ʈ)
+    uint32_t			    mSendHighWatermarkPackets;	// ۽ ť   (Ŷ )
+    uint32_t			    mSendLowWatermarkPackets;	// ۽ ť   (Ŷ )
+    bool				    mbIsProtocolV2;				// ɼ -  v2 
+    uint8_t				    mProtocolV2Key[PROTOCOL_V2_KEY_SIZE];	//  v2  Ű
+    bool				    mbIsMultiMessageFrame;		// ɼ - Ƽ ޽  
+    uint32_t			    mCompressionThreshold;		// ɼ -  ּ ̷ε ũ (0̸   )
+    bool				    mbIsRecvRateLimited;		//  ӵ    (Start )
+    ERecvRateLimitPolicy    mRecvRateLimitPolicy;		//  ӵ  ʰ  å
+    uint32_t			    mRecvPacketsPerSecond;		// Ǻ ʴ  Ŷ  
+    uint32_t			    mRecvBytesPerSecond;		// Ǻ ʴ  Ʈ 
+    uint32_t			    mRecvRateLimitTypeCount;	// Ŷ ŸԺ  
+    uint16_t			    mRecvRateLimitTypes[MAX_RECV_RATE_LIMIT_TYPE_COUNT];				//  Ŷ ŸԵ
+    uint32_t			    mRecvRateLimitTypePacketsPerSecond[MAX_RECV_RATE_LIMIT_TYPE_COUNT];	// Ŷ ŸԺ ʴ  Ŷ  
     uint32_t			    mMaxSessionCount;			//  ִ  
     uint32_t			    mThreadCount;				//   
     HANDLE* mThreads;					                //   
-    MonitoringVariables     mMonitoringVariables;		// ͸  ϱ  
+    MonitoringCounterBlock* mCounterBlocks;				// 庰 ī  [Ŀ][Accept ][ (  , Interlocked)]
+    uint32_t			    mCounterBlockCount;
     MonitoringVariables     mMonitorResult;				// ͸   ( ʸ ŵ)
     uint64_t			    mSessionAcceptedCount;		//  ۵ ĺ ݱ   
     uint64_t			    mSessionDisconnectedCount;	//  ۵ ĺ ݱ   
     uint32_t			    mSessionCount;				//     
 
-    Session* mSessionList;                              //  Ʈ (Ǯ)
+    Session*                mSessionSegments[MAX_SESSION_SEGMENT_COUNT];    //  ̺ ׸Ʈ ( Ű = [׸Ʈ ε][׸Ʈ  ε])
+    uint32_t                mSessionSegmentCount;       // Ҵ ׸Ʈ 
+    uint32_t                mSessionKeyCount;           // ݱ ߱  Ű  (0 ~ mSessionKeyCount-1)
+    SRWLOCK                 mSessionTableLock;          //  ̺ ø   (ȸ  )
     LockFreeStack<uint32_t>	mUnusedSessionKeys;         //    Ű
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include <WinSock2.h>
 #include <WS2tcpip.h>
+#include <MSWSock.h>
 #include <Windows.h>
 
 #include "../Logger/Logger.h"
@@ -34,9 +35,20 @@ public:
 #pragma region  ٷ
 
     // socket()
-    inline static SOCKET    CreateSocket(void)
+    // bRegisteredIo true RIO(Registered I/O)   ִ  Ѵ
+    // ( Ͽ ϸ accept()  ϵ  Ӽ )
+    inline static SOCKET    CreateSocket(const bool bRegisteredIo = false)
     {
-        SOCKET newSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+        SOCKET newSocket;
+
+        if (bRegisteredIo)
+        {
+            newSocket = ::WSASocketW(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_REGISTERED_IO);
+        }
+        else
+        {
+            newSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+        }
 
         ASSERT_LIVE(newSocket != INVALID_SOCKET, L"CreateSocket() failed");
 
@@ -147,6 +159,76 @@ public:
 
 #pragma endregion
 
+#pragma region AcceptEx 
+
+    // AcceptEx Ȯ Լ (LoadAcceptExFunctions() ȣ   )
+    inline static LPFN_ACCEPTEX& AcceptEx(void)
+    {
+        static LPFN_ACCEPTEX acceptEx = nullptr;
+        return acceptEx;
+    }
+
+    // GetAcceptExSockaddrs Ȯ Լ (LoadAcceptExFunctions() ȣ   )
+    inline static LPFN_GETACCEPTEXSOCKADDRS& GetAcceptExSockaddrs(void)
+    {
+        static LPFN_GETACCEPTEXSOCKADDRS getAcceptExSockaddrs = nullptr;
+        return getAcceptExSockaddrs;
+    }
+
+    // WSAIoctl(SIO_GET_EXTENSION_FUNCTION_POINTER) AcceptEx, GetAcceptExSockaddrs Լ ͸ ´
+    inline static void      LoadAcceptExFunctions(const SOCKET listenSocket)
+    {
+        GUID acceptExID = WSAID_ACCEPTEX;
+        GUID getAcceptExSockaddrsID = WSAID_GETACCEPTEXSOCKADDRS;
+        DWORD bytes = 0;
+
+        int retWSAIoctl = ::WSAIoctl(listenSocket, SIO_GET_EXTENSION_FUNCTION_POINTER,
+            &acceptExID, sizeof(acceptExID), &AcceptEx(), sizeof(LPFN_ACCEPTEX), &bytes, NULL, NULL);
+
+        ASSERT_LIVE(retWSAIoctl != SOCKET_ERROR, L"LoadAcceptExFunctions() AcceptEx failed");
+
+        retWSAIoctl = ::WSAIoctl(listenSocket, SIO_GET_EXTENSION_FUNCTION_POINTER,
+            &getAcceptExSockaddrsID, sizeof(getAcceptExSockaddrsID), &GetAcceptExSockaddrs(), sizeof(LPFN_GETACCEPTEXSOCKADDRS), &bytes, NULL, NULL);
+
+        ASSERT_LIVE(retWSAIoctl != SOCKET_ERROR, L"LoadAcceptExFunctions() GetAcceptExSockaddrs failed");
+    }
+
+    // setsockopt(SO_UPDATE_ACCEPT_CONTEXT) - AcceptEx     Ӽ ޵ 
+    inline static void      UpdateAcceptContext(const SOCKET acceptedSocket, const SOCKET listenSocket)
+    {
+        int retSetsockopt = ::setsockopt(acceptedSocket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, (const char*)&listenSocket, sizeof(listenSocket));
+
+        ASSERT_LIVE(retSetsockopt != SOCKET_ERROR, L"UpdateAcceptContext() failed");
+    }
+
+#pragma endregion
+
+#pragma region RIO 
+
+    // RIO Ȯ Լ ̺ (LoadRioFunctionTable() ȣ   )
+    inline static RIO_EXTENSION_FUNCTION_TABLE& Rio(void)
+    {
+        static RIO_EXTENSION_FUNCTION_TABLE rioFunctionTable{};
+        return rioFunctionTable;
+    }
+
+    // WSAIoctl(SIO_GET_MULTIPLE_EXTENSION_FUNCTION_POINTER) RIO Լ ̺ ´
+    // ڷ ѱ  WSA_FLAG_REGISTERED_IO  ̾ 
+    inline static void      LoadRioFunctionTable(const SOCKET socket)
+    {
+        GUID functionTableID = WSAID_MULTIPLE_RIO;
+        DWORD bytes = 0;
+
+        Rio().cbSize = sizeof(RIO_EXTENSION_FUNCTION_TABLE);
+
+        int retWSAIoctl = ::WSAIoctl(socket, SIO_GET_MULTIPLE_EXTENSION_FUNCTION_POINTER,
+            &functionTableID, sizeof(functionTableID), &Rio(), sizeof(RIO_EXTENSION_FUNCTION_TABLE), &bytes, NULL, NULL);
+
+        ASSERT_LIVE(retWSAIoctl != SOCKET_ERROR, L"LoadRioFunctionTable() failed");
+    }
+
+#pragma endregion
+
 #pragma region ּ ȯ
 
     inline static std::wstring      GetIpAddress(const SOCKADDR_IN address)
@@ -1,28 +1,36 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 
 #define NETWORK_HEADER_TYPE_LAN 0 // LAN  : ̸ 
 #define NETWORK_HEADER_TYPE_NET 1 // NET  :  ڵ ߰  Ŷ ȣȭ/ȣȭ 
 
+// ⺻   (NetClient, NetServer::Start() ʰ ), ʸ ٸ  NetServer::AddListener() ߰
 #define NETWORK_HEADER_USE_TYPE NETWORK_HEADER_TYPE_NET
 
-#if NETWORK_HEADER_USE_TYPE == NETWORK_HEADER_TYPE_LAN
+#define NETWORK_HEADER_CODE 0x77      //  Ŷ ɷ   
+#define NETWORK_HEADER_FIXED_KEY 0x32 // ޽ ȣȭ   Ű
+#define NETWORK_HEADER_CODE_V2_HELLO 0x78 //  v2 ڵũ(hello) Ŷ   (̷ε 8Ʈ nonce, )
+#define NETWORK_HEADER_CODE_MULTI_MESSAGE 0x79 // Ƽ ޽    (̷ε [uint16_t ][޽] ݺ, ڵ/üũ ̷ε ü  )
+#define NETWORK_HEADER_CODE_COMPRESSED 0x7A //  Ŷ   (̷ε [uint16_t  ][ ̷ε LZ4 ])
 
-struct NetworkHeader
+//   ( NETWORK_HEADER_TYPE_XXX )
+enum class ENetworkHeaderProfile : uint8_t
 {
-	uint16_t Length;  // ̷ε  ( )
+	Lan = NETWORK_HEADER_TYPE_LAN,
+	Net = NETWORK_HEADER_TYPE_NET
 };
 
-static_assert(sizeof(NetworkHeader) == 2);
-
-#elif NETWORK_HEADER_USE_TYPE == NETWORK_HEADER_TYPE_NET
+struct LanNetworkHeader
+{
+	uint16_t Length;  // ̷ε  ( )
+};
 
-#define NETWORK_HEADER_CODE 0x77      //  Ŷ ɷ   
-#define NETWORK_HEADER_FIXED_KEY 0x32 // ޽ ȣȭ   Ű
+static_assert(sizeof(LanNetworkHeader) == 2);
 
 #pragma pack (push,1)
-struct NetworkHeader
+struct NetNetworkHeader
 {
     uint8_t     Code;       // NETWORK_HEADER_CODE  
     uint16_t    Length;     // ̷ε  ( )
@@ -31,6 +39,21 @@ struct NetworkHeader
 };
 #pragma pack (pop)
 
-static_assert(sizeof(NetworkHeader) == 5);
+static_assert(sizeof(NetNetworkHeader) == 5);
+
+// Ͽ شϴ  Ÿ ( ,   Ϻ Ưȭ  )
+template <ENetworkHeaderProfile PROFILE>
+using NetworkHeaderOf = std::conditional_t<PROFILE == ENetworkHeaderProfile::Lan, LanNetworkHeader, NetNetworkHeader>;
+
+// ȭ ۰ ̷ε տ δ ũ (   )
+constexpr uint32_t MAX_NETWORK_HEADER_SIZE = sizeof(NetNetworkHeader);
+
+constexpr ENetworkHeaderProfile DEFAULT_NETWORK_HEADER_PROFILE = static_cast<ENetworkHeaderProfile>(NETWORK_HEADER_USE_TYPE);
+
+using NetworkHeader = NetworkHeaderOf<DEFAULT_NETWORK_HEADER_PROFILE>;
+
+// Ƽ ޽ ӿ ޽ տ ٴ  (޽ ,  ڽ )
+constexpr uint32_t MULTI_MESSAGE_LENGTH_SIZE = sizeof(uint16_t);
 
-#endif
\ No newline at end of file
+// Ƽ ޽  ̿  Ʈ  ִٸ  ޽ (NETWORK_HEADER_CODE_COMPRESSED Ŷ ̷ε)
+constexpr uint16_t MULTI_MESSAGE_COMPRESSED_FLAG = 0x8000;
@@ -9,6 +9,7 @@ public:
 
     RingBuffer() : mCapacity(DEFAULT_SIZE) { mBuffer = new char[DEFAULT_SIZE]; }
     RingBuffer(int bufferSize) : mCapacity(bufferSize) { mBuffer = new char[bufferSize]; }
+    RingBuffer(int bufferSize, bool bAllocate) : mCapacity(bufferSize) { mBuffer = bAllocate ? new char[bufferSize] : nullptr; }
     ~RingBuffer() { delete mBuffer; }
 
     inline void  ClearBuffer(void) { mFront = mRear = 0; }
@@ -18,6 +19,14 @@ public:
     inline int   GetFreeSize(void) const { return mCapacity - GetUseSize() - 1; }
     inline char* GetFrontBufferPtr(void) const { return mBuffer + mFront; }
     inline char* GetRearBufferPtr(void) const { return mBuffer + mRear; }
+    inline char* GetBufferPtr(void) const { return mBuffer; }
+    inline int   GetRearOffset(void) const { return mRear; }
+    inline int   GetMappedSize(void) const { return mCapacity; }
+
+    // ܺο Ҵ ۸ ̰ų  ( ũ 뷮 ƾ ,    ȣ ʿ)
+    inline bool  HasBuffer(void) const { return mBuffer != nullptr; }
+    inline void  AttachBuffer(char* buffer) { mBuffer = buffer; }
+    inline char* DetachBuffer(void) { char* ret = mBuffer; mBuffer = nullptr; return ret; }
 
     //  ͷ ܺο ѹ濡   ִ 
     inline int GetDirectEnqueueSize(void) const
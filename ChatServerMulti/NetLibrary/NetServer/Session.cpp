@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "NetUtils.h"
 
 #include "Session.h"
@@ -7,7 +9,7 @@
 #include "NetServer.h"
 #include "../Profiler/Profiler.h"
 
-void Session::Init(const SOCKET sock, const SOCKADDR_IN address, NetServer* netServer, const uint64_t sessionID, const uint32_t sessionListKey)
+void Session::Init(const SOCKET sock, const SOCKADDR_IN address, NetServer* netServer, const uint64_t sessionID, const uint32_t sessionListKey, const HANDLE iocp, const ENetworkHeaderProfile headerProfile)
 {
     //  ÷׸ Ѵ - ش  IoCount ٸ ǿ ǵ帱  ֱ⿡ Interlocked ʿ
     InterlockedAnd(reinterpret_cast<LONG*>(&IoCount), 0x7FFF'FFFF);
@@ -16,14 +18,35 @@ void Session::Init(const SOCKET sock, const SOCKADDR_IN address, NetServer* netS
     Socket = sock;
     Address = address;
     Server = netServer;
+    IOCP = iocp;
+    HeaderProfile = headerProfile;
 
     ::memset(&SendOverlapped, 0, sizeof(OVERLAPPED));
     ::memset(&RecvOverlapped, 0, sizeof(OVERLAPPED));
 
     bSendFlag = 0;
+    bFlushRegistered = 0;
+    bLingerRegistered = 0;
+    SendQueueBytes = 0;
+    LingerMicroseconds = Server->mSendLingerMicroseconds;
+    LingerBytes = Server->mSendLingerBytes;
     SessionListKey = sessionListKey;
     bDisconnected = false;
     bDisconnectRegistered = false;
+    bSlowConsumer = false;
+    bZeroByteRecv = false;
+
+    // v2 ɼ  ִٸ ù  ͸     ۽ Ѵ (NET  ʸ)
+    Protocol = (Server->mbIsProtocolV2 && HeaderProfile == ENetworkHeaderProfile::Net) ? ESessionProtocol::Undecided : ESessionProtocol::V1;
+    CipherSendPrefixBytes = 0;
+    bMultiMessageFrame = false;
+    bCompression = false;
+
+    // ù   1 з  ä
+    RecvTokenRefillMicroseconds = 0;
+    RecvPacketTokens = 0;
+    RecvByteTokens = 0;
+    ::memset(RecvTypePacketTokens, 0, sizeof(RecvTypePacketTokens));
 
     RecvBuffer.ClearBuffer();
 
@@ -34,12 +57,27 @@ void Session::Init(const SOCKET sock, const SOCKADDR_IN address, NetServer* netS
         packet->DecrementRefCount();
     }
 
+    while (!LocalSendQueue.empty())
+    {
+        LocalSendQueue.front()->DecrementRefCount();
+        LocalSendQueue.pop_front();
+    }
+
     for (uint32_t i = 0; i < RegisteredPacketCount; ++i)
     {
         RegisteredPackets[i]->DecrementRefCount();
     }
 
     RegisteredPacketCount = 0;
+
+    if (PendingCopyPacket != nullptr)
+    {
+        PendingCopyPacket->DecrementRefCount();
+        PendingCopyPacket = nullptr;
+    }
+
+    PendingCopyOffset = 0;
+    CopiedPacketCount = 0;
 }
 
 bool Session::DecrementIoCount()
@@ -65,13 +103,18 @@ bool Session::DecrementIoCount()
 
     /************************** release session **************************/
 
-    ASSERT_LIVE(TryClosesocket(), L"TryClosesocket failed");
+    // RIO  Disconnect()  ̹  ݾ  ִ
+    bool retTryClosesocket = TryClosesocket();
+    ASSERT_LIVE(retTryClosesocket || Server->mIoEngine == EIoEngine::Rio, L"TryClosesocket failed");
 
     InterlockedIncrement(&Server->mSessionDisconnectedCount);
     InterlockedDecrement(&Server->mSessionCount);
 
+    //  I/O Ƿ   ۸ ݳ
+    releaseRecvBuffer();
+
     // OnRelease ȣ ٸ   Ͷ    ȸѴ
-    ::PostQueuedCompletionStatus(Server->mIOCP, 0, ID, 0);
+    ::PostQueuedCompletionStatus(IOCP, 0, ID, 0);
 
     //  Ű ε ݳ
     Server->mUnusedSessionKeys.Push(SessionListKey);
@@ -86,11 +129,26 @@ bool Session::PostRecv()
         return false;
     }
 
+    if (Server->mIoEngine == EIoEngine::Rio)
+    {
+        return postRecvRio();
+    }
+
     WSABUF wsabuf;
     DWORD flags = 0;
 
-    wsabuf.buf = RecvBuffer.GetRearBufferPtr();
-    wsabuf.len = RecvBuffer.GetDirectEnqueueSize();
+    //   Ǯ  -  ۰ ٸ 0Ʈ     ޴´
+    if (Server->mbIsPooledRecvBuffer && !RecvBuffer.HasBuffer())
+    {
+        bZeroByteRecv = true;
+        wsabuf.buf = nullptr;
+        wsabuf.len = 0;
+    }
+    else
+    {
+        wsabuf.buf = RecvBuffer.GetRearBufferPtr();
+        wsabuf.len = RecvBuffer.GetDirectEnqueueSize();
+    }
 
     ::ZeroMemory(&RecvOverlapped, sizeof(RecvOverlapped));
 
@@ -114,7 +172,7 @@ bool Session::PostRecv()
                 ::CancelIoEx((HANDLE)Socket, NULL);
             }
 
-            InterlockedIncrement(&Server->mMonitoringVariables.RecvPendingTPS);
+            Server->addCounter(&MonitoringCounterBlock::RecvPendingTPS);
         }
         break;
         case WSAECONNRESET:
@@ -140,9 +198,10 @@ bool Session::PostRecv()
 
 bool Session::PostSend()
 {
-    uint32_t sendCount = SendQueue.GetCount();
+    uint32_t sendCount = getSendQueueCount();
 
-    if (sendCount <= 0 || bDisconnected || bDisconnectRegistered)
+    // ۽ ۿ ϴ (RIO,  v2, Ƽ ޽ )  ۽ſ    Ŷ̳ ̸ ä hello   ִ
+    if ((sendCount <= 0 && PendingCopyPacket == nullptr && CipherSendPrefixBytes == 0) || bDisconnected || bDisconnectRegistered || Protocol == ESessionProtocol::Undecided)
     {
         return false;
     }
@@ -152,35 +211,67 @@ bool Session::PostSend()
         return false;
     }
 
-    sendCount = SendQueue.GetCount();
+    sendCount = getSendQueueCount();
 
-    if (sendCount <= 0)
+    if (sendCount <= 0 && PendingCopyPacket == nullptr && CipherSendPrefixBytes == 0)
     {
         ASSERT_LIVE(InterlockedExchange(&bSendFlag, 0) == 1, L"more than 1 Send Error");
 
         return false;
     }
 
+    if (Server->mIoEngine == EIoEngine::Rio)
+    {
+        return postSendRio();
+    }
+
+    // ť  ŭ    (ִ MAX_WSA_BUF_COUNT, Ʈ  ѱ ߴ)
     WSABUF wsabuf[MAX_WSA_BUF_COUNT];
     int wsaBufCount;
+    uint32_t gatheredBytes = 0;
 
-    for (wsaBufCount = 0; wsaBufCount < MAX_WSA_BUF_COUNT; ++wsaBufCount)
+    //  v2 Ǹ  ȣȭؾ ϰ, Ƽ ޽  ̷ε ϳ  ϹǷ Ŷ ۸ ״  ʰ ۽ ۿ ؼ 
+    if (Protocol == ESessionProtocol::V2 || bMultiMessageFrame)
+    {
+        wsabuf[0].buf = CopySendBuffer;
+        wsabuf[0].len = copySendPackets(CopySendBuffer, COPY_SEND_BUFFER_SIZE);
+        wsaBufCount = (wsabuf[0].len > 0) ? 1 : 0;
+    }
+    else
     {
-        if (sendCount == 0)
+        for (wsaBufCount = 0; wsaBufCount < MAX_WSA_BUF_COUNT; ++wsaBufCount)
         {
-            break;
-        }
+            if (sendCount == 0 || gatheredBytes >= Server->mSendGatherByteBudget)
+            {
+                break;
+            }
 
-        Serializer* packet;
-        bool retTryDequeue = SendQueue.TryDequeue(packet);
-        ASSERT_LIVE(retTryDequeue, L"SendQueue TryDequeue Failed");
+            Serializer* packet;
+            bool retTryDequeue = tryDequeueSendPacket(packet);
+            ASSERT_LIVE(retTryDequeue, L"SendQueue TryDequeue Failed");
+
+            sendCount--;
+
+            wsabuf[wsaBufCount].buf = packet->GetFullBufferPointer();
+            wsabuf[wsaBufCount].len = packet->GetFullSize();
+
+            gatheredBytes += wsabuf[wsaBufCount].len;
 
-        sendCount--;
+            // RegisteredPackets ϸ ø (bSendFlag  常 )
+            if (RegisteredPacketCount == RegisteredPacketCapacity)
+            {
+                growRegisteredPackets();
+            }
+
+            RegisteredPackets[RegisteredPacketCount++] = packet;
+        }
+    }
 
-        wsabuf[wsaBufCount].buf = packet->GetFullBufferPointer();
-        wsabuf[wsaBufCount].len = packet->GetFullSize();
+    if (wsaBufCount == 0)
+    {
+        ASSERT_LIVE(InterlockedExchange(&bSendFlag, 0) == 1, L"more than 1 Send Error");
 
-        RegisteredPackets[RegisteredPacketCount++] = packet;
+        return false;
     }
 
     ::ZeroMemory(&SendOverlapped, sizeof(SendOverlapped));
@@ -205,7 +296,7 @@ bool Session::PostSend()
                 ::CancelIoEx((HANDLE)Socket, NULL);
             }
 
-            InterlockedIncrement(&Server->mMonitoringVariables.SendPendingTPS);
+            Server->addCounter(&MonitoringCounterBlock::SendPendingTPS);
         }
         break;
         case WSAECONNRESET:
@@ -246,3 +337,397 @@ bool Session::TryClosesocket()
 
     return true;
 }
+
+void Session::growRegisteredPackets()
+{
+    ASSERT_LIVE(RegisteredPacketCapacity < MAX_WSA_BUF_COUNT, L"RegisteredPackets capacity overflow");
+
+    uint32_t newCapacity = RegisteredPacketCapacity * 2;
+
+    if (newCapacity > MAX_WSA_BUF_COUNT)
+    {
+        newCapacity = MAX_WSA_BUF_COUNT;
+    }
+
+    Serializer** newRegisteredPackets = new Serializer*[newCapacity];
+    ::memcpy(newRegisteredPackets, RegisteredPackets, sizeof(Serializer*) * RegisteredPacketCount);
+
+    delete[] RegisteredPackets;
+
+    RegisteredPackets = newRegisteredPackets;
+    RegisteredPacketCapacity = newCapacity;
+}
+
+void Session::initRecvBuffer(const bool bPooled)
+{
+#if !SESSION_RECV_BUFFER_USE_MIRRORED
+    if (!bPooled)
+    {
+        RecvBuffer.AttachBuffer(new char[RingBuffer::DEFAULT_SIZE]);
+    }
+#endif
+}
+
+void Session::acquireRecvBuffer()
+{
+#if !SESSION_RECV_BUFFER_USE_MIRRORED
+    if (RecvBuffer.HasBuffer())
+    {
+        return;
+    }
+
+    RecvBuffer.ClearBuffer();
+    RecvBuffer.AttachBuffer(Server->mRecvBufferPool->Alloc()->Data);
+#endif
+}
+
+void Session::releaseRecvBuffer()
+{
+#if !SESSION_RECV_BUFFER_USE_MIRRORED
+    if (!RecvBuffer.HasBuffer() || !Server->mbIsPooledRecvBuffer)
+    {
+        return;
+    }
+
+    RecvBuffer.ClearBuffer();
+    Server->mRecvBufferPool->Free(reinterpret_cast<RecvBufferBlock*>(RecvBuffer.DetachBuffer()));
+#endif
+}
+
+uint32_t Session::getSendQueueCount() const
+{
+    if (Server->mbIsSharded)
+    {
+        return static_cast<uint32_t>(LocalSendQueue.size());
+    }
+
+    return SendQueue.GetCount();
+}
+
+void Session::enqueueSendPacket(Serializer* packet)
+{
+    // ٸ Ϸ غ Ŷ -    ִ  纻 ű
+    if (packet->GetHeaderProfile() != HeaderProfile)
+    {
+        Serializer* convertedPacket = packet->copyForHeaderProfile(HeaderProfile);
+        packet->DecrementRefCount();
+        packet = convertedPacket;
+    }
+
+    // ົ  û     Ѵ (پ ʴ Ŷ̶ nullptr)
+    if (bCompression && packet->GetUseSize() >= Server->mCompressionThreshold)
+    {
+        Serializer* compressedPacket = Server->getCompressedPacket(packet);
+
+        if (compressedPacket != nullptr)
+        {
+            compressedPacket->IncrementRefCount();
+            packet->DecrementRefCount();
+            packet = compressedPacket;
+        }
+    }
+
+    InterlockedAdd(reinterpret_cast<LONG*>(&SendQueueBytes), static_cast<LONG>(packet->GetFullSize()));
+
+    if (Server->mbIsSharded)
+    {
+        LocalSendQueue.push_back(packet);
+        return;
+    }
+
+    SendQueue.Enqueue(packet);
+}
+
+bool Session::tryDequeueSendPacket(Serializer*& outPacket)
+{
+    if (Server->mbIsSharded)
+    {
+        if (LocalSendQueue.empty())
+        {
+            return false;
+        }
+
+        outPacket = LocalSendQueue.front();
+        LocalSendQueue.pop_front();
+    }
+    else if (false == SendQueue.TryDequeue(outPacket))
+    {
+        return false;
+    }
+
+    InterlockedAdd(reinterpret_cast<LONG*>(&SendQueueBytes), -static_cast<LONG>(outPacket->GetFullSize()));
+
+    return true;
+}
+
+bool Session::dropOldestDroppablePacket()
+{
+    auto it = std::find_if(LocalSendQueue.begin(), LocalSendQueue.end(), [](const Serializer* packet) { return packet->IsDroppable(); });
+
+    if (it == LocalSendQueue.end())
+    {
+        return false;
+    }
+
+    Serializer* packet = *it;
+    LocalSendQueue.erase(it);
+
+    InterlockedAdd(reinterpret_cast<LONG*>(&SendQueueBytes), -static_cast<LONG>(packet->GetFullSize()));
+
+    packet->DecrementRefCount();
+
+    return true;
+}
+
+bool Session::postRecvRio()
+{
+    RIO_BUF rioBuf;
+    rioBuf.BufferId = RioRecvBufferID;
+    rioBuf.Offset = RecvBuffer.GetRearOffset();
+    rioBuf.Length = RecvBuffer.GetDirectEnqueueSize();
+
+    IncrementIoCount();
+
+    ::AcquireSRWLockExclusive(&RioLock);
+
+    // Disconnect()  ݾҴٸ Request Queue Բ Ƿ û ʴ´
+    if (bDisconnected)
+    {
+        ::ReleaseSRWLockExclusive(&RioLock);
+        return DecrementIoCount();
+    }
+
+    PROFILE_BEGIN(L"RIOReceive");
+    BOOL retRIOReceive = NetUtils::Rio().RIOReceive(RioRequestQueue, &rioBuf, 1, 0, &RecvOverlapped);
+    PROFILE_END(L"RIOReceive");
+
+    int errorCode = (retRIOReceive == FALSE) ? ::WSAGetLastError() : 0;
+
+    ::ReleaseSRWLockExclusive(&RioLock);
+
+    bool ret = false;
+
+    if (retRIOReceive == FALSE)
+    {
+        switch (errorCode)
+        {
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+        {
+            ret = DecrementIoCount();
+        }
+        break;
+        default:
+            LOGF(ELogLevel::Error, L"RIOReceive Error (errorCode = %d)", errorCode);
+            Logger::RaiseCrash();
+        }
+    }
+    else
+    {
+        Server->addCounter(&MonitoringCounterBlock::RecvPendingTPS);
+    }
+
+    return ret;
+}
+
+uint32_t Session::copySendPackets(char* sendBuffer, const uint32_t bufferSize)
+{
+    // 縦 ģ Ŷ ٷ ϰ,    Ŷ ܵξٰ  ۽ſ ̾ Ѵ
+    //  helloó ̸ ä  ״ ΰ  ڿ ̾δ
+    const uint32_t prefixSize = CipherSendPrefixBytes;
+    uint32_t copySize = prefixSize;
+
+    CipherSendPrefixBytes = 0;
+
+    // Ƽ ޽  -  ϴ Ŷ ִٸ (ѱ   Ŷ)  Ŷ   ں ´
+    if (bMultiMessageFrame && PendingCopyOffset == 0)
+    {
+        PROFILE_BEGIN(L"PackMultiMessageFrame");
+        copySize += packMultiMessageFrame(sendBuffer + copySize, bufferSize - copySize);
+        PROFILE_END(L"PackMultiMessageFrame");
+    }
+    else
+    {
+        while (copySize < bufferSize)
+        {
+            Serializer* packet = PendingCopyPacket;
+
+            if (packet == nullptr)
+            {
+                if (false == tryDequeueSendPacket(packet))
+                {
+                    break;
+                }
+
+                PendingCopyOffset = 0;
+            }
+
+            uint32_t remainSize = packet->GetFullSize() - PendingCopyOffset;
+            uint32_t copyableSize = bufferSize - copySize;
+
+            if (remainSize > copyableSize)
+            {
+                //  v2    ǵ ϹǷ  ʰ  ۽ ѱ ( ۽ ۿ ׻ )
+                if (Protocol == ESessionProtocol::V2)
+                {
+                    PendingCopyPacket = packet;
+                    break;
+                }
+
+                ::memcpy(sendBuffer + copySize, packet->GetFullBufferPointer() + PendingCopyOffset, copyableSize);
+                copySize += copyableSize;
+
+                PendingCopyPacket = packet;
+                PendingCopyOffset += copyableSize;
+
+                break;
+            }
+
+            ::memcpy(sendBuffer + copySize, packet->GetFullBufferPointer() + PendingCopyOffset, remainSize);
+
+            // Ŷ     v1 ڵǾ Ƿ 纻  ǵ (v2 NET  Ǹ )
+            if (Protocol == ESessionProtocol::V2)
+            {
+                Serializer::decodeFrame(sendBuffer + copySize);
+            }
+
+            copySize += remainSize;
+
+            PendingCopyPacket = nullptr;
+            PendingCopyOffset = 0;
+            CopiedPacketCount++;
+
+            packet->DecrementRefCount();
+        }
+    }
+
+    //  ӵ   ȣȭ (    ó)
+    if (Protocol == ESessionProtocol::V2)
+    {
+        SendCipher.Process(sendBuffer + prefixSize, copySize - prefixSize);
+    }
+
+    return copySize;
+}
+
+uint32_t Session::packMultiMessageFrame(char* frameBuffer, const uint32_t bufferSize)
+{
+    // [NetNetworkHeader][][޽][][޽]... - Ŷ   (NET) ڵǾ Ƿ ϸ鼭  ǵ
+    uint32_t frameSize = sizeof(NetNetworkHeader);
+    uint32_t messageCount = 0;
+    uint32_t unframedSize = 0;
+
+    for (;;)
+    {
+        Serializer* packet = PendingCopyPacket;
+
+        if (packet == nullptr && false == tryDequeueSendPacket(packet))
+        {
+            break;
+        }
+
+        const uint32_t messageSize = packet->GetUseSize();
+
+        //       ѱ ( ӿ ׻ )
+        if (frameSize + MULTI_MESSAGE_LENGTH_SIZE + messageSize > bufferSize)
+        {
+            PendingCopyPacket = packet;
+            break;
+        }
+
+        // [üũ][̷ε]  ڸ  ° Ʈ Ǯ  ̷  (ົ̶ ̿ ǥ)
+        const bool bCompressed = reinterpret_cast<const NetNetworkHeader*>(packet->GetFullBufferPointer())->Code == NETWORK_HEADER_CODE_COMPRESSED;
+
+        char* messageLength = frameBuffer + frameSize;
+        Serializer::decodeFrameTo(packet->GetFullBufferPointer(), messageLength + MULTI_MESSAGE_LENGTH_SIZE - 1);
+        *reinterpret_cast<uint16_t*>(messageLength) = static_cast<uint16_t>(messageSize | (bCompressed ? MULTI_MESSAGE_COMPRESSED_FLAG : 0u));
+
+        frameSize += MULTI_MESSAGE_LENGTH_SIZE + messageSize;
+        unframedSize += packet->GetFullSize();
+        messageCount++;
+
+        PendingCopyPacket = nullptr;
+        CopiedPacketCount++;
+
+        packet->DecrementRefCount();
+    }
+
+    if (messageCount == 0)
+    {
+        return 0;
+    }
+
+    NetNetworkHeader* header = reinterpret_cast<NetNetworkHeader*>(frameBuffer);
+    header->Code = NETWORK_HEADER_CODE_MULTI_MESSAGE;
+    header->Length = static_cast<uint16_t>(frameSize - sizeof(NetNetworkHeader));
+    header->RandKey = rand();
+    header->CheckSum = Serializer::sumBytes(reinterpret_cast<const unsigned char*>(frameBuffer + sizeof(NetNetworkHeader)), header->Length);
+
+    //  v2 Ʈ ü ȣȭϹǷ   ״ д
+    if (Protocol == ESessionProtocol::V1)
+    {
+        Serializer::encodeFrame(frameBuffer);
+    }
+
+    Server->addCounter(&MonitoringCounterBlock::MultiMessageFrameTPS);
+    Server->addCounter(&MonitoringCounterBlock::MultiMessageFramePacketTPS, messageCount);
+    Server->addCounter(&MonitoringCounterBlock::MultiMessageFrameBytesTPS, frameSize);
+    Server->addCounter(&MonitoringCounterBlock::MultiMessageFrameUnframedBytesTPS, unframedSize);
+
+    return frameSize;
+}
+
+bool Session::postSendRio()
+{
+    // RIOSend ۸ ϳ Ƿ ϵ ۽ ۿ Ŷ ̾ٿ   
+    uint32_t copySize = copySendPackets(RioSendBuffer, RIO_SEND_BUFFER_SIZE);
+
+    ASSERT_LIVE(copySize > 0, L"RIO send buffer is empty");
+
+    RIO_BUF rioBuf;
+    rioBuf.BufferId = Server->mRioSendBufferID;
+    rioBuf.Offset = RioSendOffset;
+    rioBuf.Length = copySize;
+
+    IncrementIoCount();
+
+    ::AcquireSRWLockExclusive(&RioLock);
+
+    if (bDisconnected)
+    {
+        ::ReleaseSRWLockExclusive(&RioLock);
+        return DecrementIoCount();
+    }
+
+    PROFILE_BEGIN(L"RIOSend");
+    BOOL retRIOSend = NetUtils::Rio().RIOSend(RioRequestQueue, &rioBuf, 1, 0, &SendOverlapped);
+    PROFILE_END(L"RIOSend");
+
+    int errorCode = (retRIOSend == FALSE) ? ::WSAGetLastError() : 0;
+
+    ::ReleaseSRWLockExclusive(&RioLock);
+
+    bool ret = false;
+
+    if (retRIOSend == FALSE)
+    {
+        switch (errorCode)
+        {
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+        {
+            ret = DecrementIoCount();
+        }
+        break;
+        default:
+            LOGF(ELogLevel::Error, L"RIOSend Error (errorCode = %d)", errorCode);
+            Logger::RaiseCrash();
+        }
+    }
+    else
+    {
+        Server->addCounter(&MonitoringCounterBlock::SendPendingTPS);
+    }
+
+    return ret;
+}
@@ -2,11 +2,38 @@
 
 #include <unordered_map>
 #include <stack>
+#include <deque>
 
 #include "RingBuffer.h"
+#include "MirroredRingBuffer.h"
 #include "Serializer.h"
+#include "ChaCha20.h"
 #include "../DataStructure/LockFreeQueue.h"
 
+// 1̸  ۷ MirroredRingBuffer(64KB,   )  - WSARecv ׻   ü ް Ŷ  
+// Ǹ 64KB  ޸𸮸 ϹǷ ִ   ؼ  
+#define SESSION_RECV_BUFFER_USE_MIRRORED 0
+
+#if SESSION_RECV_BUFFER_USE_MIRRORED
+using SessionRecvBuffer = MirroredRingBuffer;
+#else
+using SessionRecvBuffer = RingBuffer;
+#endif
+
+//   Ǯ 忡 ǵ      
+struct RecvBufferBlock
+{
+	char Data[RingBuffer::DEFAULT_SIZE];
+};
+
+//  ϴ  (NetServer::SetProtocolV2Key() )
+enum class ESessionProtocol : uint8_t
+{
+	Undecided,	// ù  ͸ ٸ  (۽ )
+	V1,			// Ŷ RandKey +  Ű XOR ü ڵ
+	V2			// ڵũ  Ʈ Ʈ ü ChaCha20 ȣȭ, Ŷ  
+};
+
 class NetServer;
 
 class Session
@@ -19,10 +46,14 @@ private:
 	Session(void) = default;
 #pragma warning(pop)
 
-	~Session() = default;
+	~Session()
+	{
+		delete[] RegisteredPackets;
+		delete[] CopySendBuffer;
+	}
 
 	//  ü ʱȭ
-	void Init(const SOCKET sock, const SOCKADDR_IN address, NetServer* netServer, const uint64_t sessionID, const uint32_t sessionListKey);
+	void Init(const SOCKET sock, const SOCKADDR_IN address, NetServer* netServer, const uint64_t sessionID, const uint32_t sessionListKey, const HANDLE iocp, const ENetworkHeaderProfile headerProfile);
 
 	// IO Count (Interlocked)
 	inline uint32_t IncrementIoCount(void) { return InterlockedIncrement(&IoCount); }
@@ -40,29 +71,128 @@ private:
 	// bDisconnected false, true ϰ  ݴ´
 	bool TryClosesocket(void);
 
+	//      غ (  Ǯ 尡 ƴ϶   ۸ Ҵ)
+	void initRecvBuffer(const bool bPooled);
+
+	//   Ǯ  -  Ͱ   Ǯ ۸ ,  óϸ ݳѴ
+	void acquireRecvBuffer(void);
+	void releaseRecvBuffer(void);
+
+	// RegisteredPackets ũ⸦ 2 ø (ִ MAX_WSA_BUF_COUNT)
+	void growRegisteredPackets(void);
+
+	// ۽  Ŷ  / ֱ /  (SendQueueBytes Բ )
+	//  忡  Ŀ ϴ LocalSendQueue, ƴ϶ SendQueue Ѵ
+	//   ϰ ٸ غ Ŷ ֱ    Ϸ غ 纻 ٲ۴
+	//   ̶ Ӱ谪 ̻ Ŷ Ŷ    ົ ٲ۴
+	uint32_t getSendQueueCount(void) const;
+	void enqueueSendPacket(Serializer* packet);
+	bool tryDequeueSendPacket(Serializer*& outPacket);
+
+	// ۽ ť   droppable Ŷ(Serializer::SetDroppable) ϳ , ٸ false
+	//    Ŀ  (۽ ť  尡 ڽŻ  ߰ Ŷ   )
+	bool dropOldestDroppablePacket(void);
+
+	// RIO  PostRecv(), PostSend()
+	//  Request Queue  RIOReceive/RIOSend/closesocket RioLock ȭѴ
+	bool postRecvRio(void);
+	bool postSendRio(void);
+
+	// ۽ ۿ Ŷ Ѵ (RIO,  v2, Ƽ ޽ ),  Ʈ  ȯ
+	//  v2 Ŷ  ʰ °θ ,    ǵ  ȣȭѴ
+	uint32_t copySendPackets(char* sendBuffer, const uint32_t bufferSize);
+
+	// ۽ ť Ŷ ̷ε带 Ƽ ޽  ϳ ´ ( 1, ڵ 1, üũ 1),  ũ⸦ ȯ
+	// ̷ε ϸ鼭  ǵ,    Ŷ PendingCopyPacket   ӿ ´ (v2 ڵ )
+	uint32_t packMultiMessageFrame(char* frameBuffer, const uint32_t bufferSize);
+
 private:
 
 	enum
 	{
-		MAX_WSA_BUF_COUNT = 10
+		MAX_WSA_BUF_COUNT = 1024,				// WSASend     ִ ִ Ŷ  ( IOV_MAX )
+		INITIAL_REGISTERED_PACKET_CAPACITY = 16,	// RegisteredPackets ʱ ũ (ϸ 2辿 MAX_WSA_BUF_COUNT ø)
+		RIO_SEND_BUFFER_SIZE = 4096 * 2,	// RIO ۽  Ǹ ϴ   ũ
+		COPY_SEND_BUFFER_SIZE = 4096 * 2,	//  v2, Ƽ ޽  ۽  Ǹ ϴ  ũ (IOCP )
+		CACHE_LINE_SIZE = 64,
+		RECV_RATE_LIMIT_TYPE_COUNT = 8	// NetServer::MAX_RECV_RATE_LIMIT_TYPE_COUNT ƾ 
 	};
-	
-	uint64_t					ID;			// [SessionList key(index) 32bit][ID++ 32bit]	
-	SOCKET						Socket;
-	SOCKADDR_IN					Address;
-	NetServer*					Server;
 
-	OVERLAPPED					SendOverlapped;
-	OVERLAPPED					RecvOverlapped;
-	
+	//   ü  ĳ    ġѴ ( 迭 ̿ , ٸ Ŀ false sharing )
+	//  ü CACHE_LINE_SIZE ĵǹǷ    ĳ    ʴ´
+	// ġ ٲٸ SessionLayoutBenchmark NewLayoutSession  ٲ  (ũⰡ ٸ static_assert  )
+
+	/************************** hot - ƹ 峪 Interlocked   **************************/
+	alignas(CACHE_LINE_SIZE)
 	uint32_t					IoCount;	// IoCount ֻ Ʈ Release Flag 
 	uint32_t					bSendFlag;
-	uint32_t					SessionListKey;
+	uint32_t					bFlushRegistered;	//  ۽ 忡  Ŀ dirty Ʈ ö ִ
+	uint32_t					bLingerRegistered;	// ۽ (linger) Ÿ̸ӿ ö ִ
+	uint32_t					SendQueueBytes;		// ۽ ť  Ʈ 
 	bool						bDisconnected;
 	bool						bDisconnectRegistered;
+	bool						bSlowConsumer;		// ۽ ť   Ѿ     true (Interlockedθ )
+	SRWLOCK						RioLock;			// RIO -  Request Queue  RIOReceive/RIOSend/closesocket ȭ (ƹ ۽ 峪 )
 
-	RingBuffer					RecvBuffer;
+	/************************** hot - ۽ ť (ƹ 峪 Enqueue) **************************/
+	alignas(CACHE_LINE_SIZE)
 	LockFreeQueue<Serializer*>	SendQueue;
+
+	/************************** warm - Init() Ŀ  ٲ ۽  д  **************************/
+	alignas(CACHE_LINE_SIZE)
+	ESessionProtocol			Protocol;				// ù  ͷ  (v2 ɼ  ִٸ ó V1), Ϸ  óϴ Ŀ Interlocked 
+	uint32_t					LingerMicroseconds;	// ۽  ð (0̸  ,   Ǻ   )
+	uint32_t					LingerBytes;		// ̸ŭ ̸  ð  ۽
+
+	// Ǻ ϴ ۽  (   , NET  Ǹ)
+	bool						bMultiMessageFrame;		// ۽ ť Ŷ  ϳ  
+	bool						bCompression;			//  Ӱ谪 ̻ Ŷ ົ 
+
+	/************************** hot - Ϸ  óϴ Ŀ   **************************/
+	alignas(CACHE_LINE_SIZE)
+	OVERLAPPED					SendOverlapped;
+	OVERLAPPED					RecvOverlapped;
 	uint32_t					RegisteredPacketCount;
-	Serializer*					RegisteredPackets[MAX_WSA_BUF_COUNT];
-};
\ No newline at end of file
+	uint32_t					RegisteredPacketCapacity;
+	Serializer**				RegisteredPackets;		// WSASend  Ŷ (۽ Ϸ  )
+	bool						bZeroByteRecv;		//   Ǯ 忡   0Ʈ WSARecv ɾ 
+	uint64_t					RecvTokenRefillMicroseconds;	//  ӵ  ū  ä ð
+	int64_t						RecvPacketTokens;		//  ӵ  ū (Ŷ 1 = 1'000'000)
+	int64_t						RecvByteTokens;			//  ӵ  ū (1Ʈ = 1'000'000)
+	int64_t						RecvTypePacketTokens[RECV_RATE_LIMIT_TYPE_COUNT];	// Ŷ ŸԺ  ӵ  ū
+#if SESSION_RECV_BUFFER_USE_MIRRORED
+	SessionRecvBuffer			RecvBuffer;
+#else
+	SessionRecvBuffer			RecvBuffer{ RingBuffer::DEFAULT_SIZE, false };	// ۴ initRecvBuffer() Ǵ acquireRecvBuffer() δ
+#endif
+	std::deque<Serializer*>		LocalSendQueue;		//    ۽ ť ( Ŀ 常 ϹǷ ȭ X)
+	ChaCha20					RecvCipher;			//  v2 - Ŭ̾Ʈ ->  Ʈ
+
+	/************************** hot - bSendFlag  常   (۽   - RIO,  v2, Ƽ ޽ ) **************************/
+	//  v2 ڵũ Ϸ  óϴ Ŀ SendCipher, CipherSendPrefixBytes   Protocol V2 ٲ۴ (  ۽ )
+	alignas(CACHE_LINE_SIZE)
+	uint32_t					CopiedPacketCount;		// ̹ ۽ ۽ ۿ 縦 ģ Ŷ  (͸)
+	Serializer*					PendingCopyPacket;		// ۽ ۿ    Ŷ
+	uint32_t					PendingCopyOffset;		// PendingCopyPacket   ġ
+	uint32_t					CipherSendPrefixBytes;	// ۽   տ ̸ ä  Ʈ  ( hello)
+	ChaCha20					SendCipher;				//  v2 -  -> Ŭ̾Ʈ Ʈ
+
+	/************************** cold - Init()(Ǵ  , Accept)  Ŀ б⸸ ϴ  **************************/
+	alignas(CACHE_LINE_SIZE)
+	uint64_t					ID;			// [SessionList key(index) 32bit][ID++ 32bit]	
+	SOCKET						Socket;
+	NetServer*					Server;
+	HANDLE						IOCP;		//    ϵ IOCP
+	ENetworkHeaderProfile		HeaderProfile;	// Accept   
+	uint32_t					SessionListKey;
+	SOCKADDR_IN					Address;
+	char*						CopySendBuffer;			// ȣȭϰų    Ŷ ϴ  (IOCP , RIO RioSendBuffer )
+
+	/************************** RIO **************************/
+	RIO_RQ						RioRequestQueue;
+	RIO_BUFFERID				RioRecvBufferID;		// RecvBuffer   ID (     )
+	char*						RioSendBuffer;			//  ϵ ۽     
+	uint32_t					RioSendOffset;			// RioSendBuffer  ۽ ۿ ϴ ġ
+};
+
+static_assert(alignof(Session) == 64 && sizeof(Session) % 64 == 0);
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <intrin.h>
+
+// α-(HDR ) ׷
+// 2 ŵ  SUB_BUCKET_COUNT յ  Ƿ   1 / SUB_BUCKET_COUNT Ϸ ϴ
+//    + īƮ    (޸ Ҵ X), ȭ  Ƿ 帶 ϳ ΰ ļ  
+// īƮ پ ʰ Ǹ (uint32_t ÷ο ),     (Subtract) Ѵ
+class LogLinearHistogram
+{
+public:
+	enum : uint32_t
+	{
+		SUB_BUCKET_BIT = 4,
+		SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BIT,
+		MAX_SHIFT = 32,												// 2^(MAX_SHIFT + SUB_BUCKET_BIT) ̻    ߸
+		BUCKET_COUNT = (MAX_SHIFT + 2) * SUB_BUCKET_COUNT
+	};
+
+public:
+	inline void Record(const uint64_t value)
+	{
+		mCounts[getBucketIndex(value)]++;
+	}
+
+	// ٸ 尡   ׷ Ѵ
+	inline void Merge(const LogLinearHistogram& other)
+	{
+		for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			mCounts[i] += *static_cast<const volatile uint32_t*>(&other.mCounts[i]);
+		}
+	}
+
+	//   ׷   ̿ ϵ  
+	inline void Subtract(const LogLinearHistogram& before)
+	{
+		for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			mCounts[i] -= before.mCounts[i];
+		}
+	}
+
+	inline uint64_t GetCount(void) const
+	{
+		uint64_t count = 0;
+
+		for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			count += mCounts[i];
+		}
+
+		return count;
+	}
+
+	// percentile(0 ~ 100) شϴ  ( ִ밪, ϵ  ٸ 0)
+	inline uint64_t GetPercentile(const double percentile) const
+	{
+		const uint64_t count = GetCount();
+
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count + 0.5);
+
+		if (rank < 1)
+		{
+			rank = 1;
+		}
+
+		uint64_t accumulated = 0;
+
+		for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			accumulated += mCounts[i];
+
+			if (accumulated >= rank)
+			{
+				return getBucketHighestValue(i);
+			}
+		}
+
+		return getBucketHighestValue(BUCKET_COUNT - 1);
+	}
+
+private:
+	static inline uint32_t getBucketIndex(const uint64_t value)
+	{
+		if (value < SUB_BUCKET_COUNT)
+		{
+			return static_cast<uint32_t>(value);
+		}
+
+		unsigned long msb;
+		_BitScanReverse64(&msb, value);
+
+		const uint32_t shift = msb - SUB_BUCKET_BIT;
+
+		if (shift > MAX_SHIFT)
+		{
+			return BUCKET_COUNT - 1;
+		}
+
+		// [2^msb, 2^(msb+1))  SUB_BUCKET_COUNT   ġ
+		return (shift + 1) * SUB_BUCKET_COUNT + static_cast<uint32_t>(value >> shift) - SUB_BUCKET_COUNT;
+	}
+
+	static inline uint64_t getBucketHighestValue(const uint32_t index)
+	{
+		if (index < SUB_BUCKET_COUNT)
+		{
+			return index;
+		}
+
+		const uint32_t shift = index / SUB_BUCKET_COUNT - 1;
+		const uint64_t subBucket = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+
+		return ((subBucket + 1) << shift) - 1;
+	}
+
+private:
+	uint32_t mCounts[BUCKET_COUNT] = {};
+};
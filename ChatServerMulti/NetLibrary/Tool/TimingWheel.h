@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+
+//  Ÿ̹ 
+//  SLOT_COUNT  ְ,    ϳ     شѴ
+// /Ҵ O(1), Advance()  ƽ  +     (   ڱ  ƿ   ܰ辿 )
+//  ϴ  ü ϴ  (޸ Ҵ X), ȭ ϴ ʿ  
+class TimingWheel
+{
+public:
+	enum
+	{
+		SLOT_BIT = 6,
+		SLOT_COUNT = 1 << SLOT_BIT,
+		SLOT_MASK = SLOT_COUNT - 1,
+		LEVEL_COUNT = 4,
+		MAX_DELTA_TICK = (1ULL << (SLOT_BIT * LEVEL_COUNT)) - 1	// ̺   ð   ߸
+	};
+
+	struct Node
+	{
+		Node*		Prev = nullptr;
+		Node*		Next = nullptr;
+		uint64_t	ExpireTick = 0;
+		void*		Owner = nullptr;	//  ݹ鿡 带  ü ã  
+
+		inline bool IsScheduled(void) const { return Next != nullptr; }
+	};
+
+public:
+	TimingWheel(void)
+	{
+		for (uint32_t level = 0; level < LEVEL_COUNT; ++level)
+		{
+			for (uint32_t slot = 0; slot < SLOT_COUNT; ++slot)
+			{
+				mSlots[level][slot].Prev = &mSlots[level][slot];
+				mSlots[level][slot].Next = &mSlots[level][slot];
+			}
+		}
+	}
+
+	TimingWheel(const TimingWheel&) = delete;
+	TimingWheel& operator=(const TimingWheel&) = delete;
+
+	inline uint64_t	GetCurrentTick(void) const { return mCurrentTick; }
+	inline uint32_t	GetCount(void) const { return mCount; }
+
+	// expireTick ǵ  (̹ ϵ  ű),  ƽ ϶  ƽ 
+	inline void Schedule(Node* node, uint64_t expireTick)
+	{
+		if (node->IsScheduled())
+		{
+			unlink(node);
+		}
+
+		if (expireTick <= mCurrentTick)
+		{
+			expireTick = mCurrentTick + 1;
+		}
+
+		node->ExpireTick = expireTick;
+		link(node);
+	}
+
+	//   (ϵ   ƹ ϵ  )
+	inline void Cancel(Node* node)
+	{
+		if (node->IsScheduled())
+		{
+			unlink(node);
+		}
+	}
+
+	// targetTick  ƽ ϸ  帶 onExpired(Node*) ȣ
+	// ݹ ȿ  带 Schedule() ٽ ص ȴ
+	template <typename Func>
+	void Advance(const uint64_t targetTick, Func&& onExpired)
+	{
+		while (mCurrentTick < targetTick)
+		{
+			mCurrentTick++;
+
+			//     Ҵٸ      ܰ Ʒ 
+			for (uint32_t level = 1; level < LEVEL_COUNT; ++level)
+			{
+				if ((mCurrentTick & ((1ULL << (SLOT_BIT * level)) - 1)) != 0)
+				{
+					break;
+				}
+
+				cascade(level, static_cast<uint32_t>(mCurrentTick >> (SLOT_BIT * level)) & SLOT_MASK);
+			}
+
+			//     ó (ݹ鿡 ٽ ϴ 尡  Ͽ  ʵ)
+			Node expired;
+			detachSlot(&mSlots[0][mCurrentTick & SLOT_MASK], &expired);
+
+			while (expired.Next != &expired)
+			{
+				Node* node = expired.Next;
+				unlink(node);
+
+				onExpired(node);
+			}
+		}
+	}
+
+private:
+	inline void link(Node* node)
+	{
+		uint64_t delta = node->ExpireTick - mCurrentTick;
+
+		if (delta > MAX_DELTA_TICK)
+		{
+			delta = MAX_DELTA_TICK;
+			node->ExpireTick = mCurrentTick + delta;
+		}
+
+		uint32_t level = 0;
+
+		while (level < LEVEL_COUNT - 1 && delta >= (1ULL << (SLOT_BIT * (level + 1))))
+		{
+			level++;
+		}
+
+		Node* head = &mSlots[level][static_cast<uint32_t>(node->ExpireTick >> (SLOT_BIT * level)) & SLOT_MASK];
+
+		node->Prev = head->Prev;
+		node->Next = head;
+		head->Prev->Next = node;
+		head->Prev = node;
+
+		mCount++;
+	}
+
+	inline void unlink(Node* node)
+	{
+		node->Prev->Next = node->Next;
+		node->Next->Prev = node->Prev;
+		node->Prev = nullptr;
+		node->Next = nullptr;
+
+		mCount--;
+	}
+
+	inline void cascade(const uint32_t level, const uint32_t slot)
+	{
+		Node pending;
+		detachSlot(&mSlots[level][slot], &pending);
+
+		while (pending.Next != &pending)
+		{
+			Node* node = pending.Next;
+			unlink(node);
+			link(node);
+		}
+	}
+
+	// head  ° outList ű ( ϵ  , Cancel() )
+	static inline void detachSlot(Node* head, Node* outList)
+	{
+		if (head->Next == head)
+		{
+			outList->Prev = outList;
+			outList->Next = outList;
+			return;
+		}
+
+		outList->Next = head->Next;
+		outList->Prev = head->Prev;
+		outList->Next->Prev = outList;
+		outList->Prev->Next = outList;
+
+		head->Prev = head;
+		head->Next = head;
+	}
+
+private:
+	Node		mSlots[LEVEL_COUNT][SLOT_COUNT];	// Ը    Ʈ Ӹ 
+	uint64_t	mCurrentTick = 0;
+	uint32_t	mCount = 0;
+};
@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include "Lock.h"
+#include "NetLibrary/Tool/TimingWheel.h"
 
 typedef wchar_t WCHAR;
 
@@ -35,8 +36,11 @@ public:
     inline uint64_t GetSessionID(void) const { return mSessionID; }
     inline uint32_t GetLastRecvTick(void) const { return mLastRecvTick; }
 
+    // the timeout wheel is not touched here; an expired entry is re-armed from mLastRecvTick when it fires
     inline void UpdateLastRecvTick(void) { mLastRecvTick = ::timeGetTime(); }
 
+    inline TimingWheel::Node* GetTimeoutNode(void) { return &mTimeoutNode; }
+
     void LogIn(const int64_t accountNo, const WCHAR id[], const WCHAR nickName[], const char sessionKey[])
     {
         mbLoggedIn = true;
@@ -68,4 +72,5 @@ private:
     WCHAR       mNickName[20];
     char        mSessionKey[64];
     SrwLock     mLock;
+    TimingWheel::Node mTimeoutNode;
 };
\ No newline at end of file
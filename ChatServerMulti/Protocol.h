@@ -25,6 +25,8 @@ enum en_PACKET_TYPE
 	//		WCHAR	ID[20]				// null 
 	//		WCHAR	Nickname[20]		// null 
 	//		char	SessionKey[64];		// ū
+	//
+	//		BYTE	Features			// ( ) ûϴ  Ʈ (en_LOGIN_FEATURE)
 	//	}
 	//
 	//------------------------------------------------------------
@@ -114,4 +116,11 @@ enum en_PACKET_TYPE
 	//  40 ̻󵿾 ޽   Ŭ̾Ʈ   .
 	//------------------------------------------------------------	
 	en_PACKET_CS_CHAT_REQ_HEARTBEAT,
+};
+
+// äü α û Features Ʈ (  ʴ  ϰ Ҵ )
+enum en_LOGIN_FEATURE
+{
+	en_LOGIN_FEATURE_MULTI_MESSAGE_FRAME = 1 << 0,	//  -> Ŭ ޽ Ƽ ޽ (NETWORK_HEADER_CODE_MULTI_MESSAGE)  
+	en_LOGIN_FEATURE_COMPRESSION = 1 << 1,			//  -> Ŭ ޽    ũ ̻   Ŷ(NETWORK_HEADER_CODE_COMPRESSED, [WORD  ][LZ4 ]) 
 };
\ No newline at end of file
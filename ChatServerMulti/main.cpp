@@ -17,18 +17,76 @@ int main(void)
 
     // config input
     uint32_t inputPortNumber;
+    uint32_t inputLanPortNumber;
     uint32_t inputMaxSessionCount;
     uint32_t inputConcurrentThreadCount;
     uint32_t inputWorkerThreadCount;
     uint32_t inputSetTcpNodelay;
     uint32_t inputSetSendBufZero;
+    uint32_t inputIocpPerWorker;
+    uint32_t inputIoEngine;
+    uint32_t inputAcceptOnWorkers;
+    uint32_t inputSharded;
+    uint32_t inputWorkerAffinity;
+    uint32_t inputCompletionBatchSize;
+    uint32_t inputSendGatherByteBudget;
+    uint32_t inputDeferredSendFlush;
+    uint32_t inputSendLingerMicroseconds;
+    uint32_t inputSendLingerBytes;
+    uint32_t inputZeroCopyRecv;
+    uint32_t inputRecvBufferPool;
+    uint32_t inputSlowConsumerPolicy;
+    uint32_t inputSendHighWatermarkBytes;
+    uint32_t inputSendLowWatermarkBytes;
+    uint32_t inputSendHighWatermarkPackets;
+    uint32_t inputSendLowWatermarkPackets;
+    uint32_t inputRecvRateLimitPolicy;
+    uint32_t inputRecvPacketsPerSecond;
+    uint32_t inputRecvBytesPerSecond;
+    uint32_t inputRecvChatMessagesPerSecond;
+    uint32_t inputTimeoutCheckInterval;
+    uint32_t inputTimeoutLoggedIn;
+    uint32_t inputTimeoutNotLoggedIn;
+    uint32_t inputMultiMessageFrame;
+    uint32_t inputCompressionThreshold;
+    char inputProtocolV2Key[NetServer::PROTOCOL_V2_KEY_SIZE * 2 + 1]{};
 
     ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "PORT", &inputPortNumber), L"ERROR: config file read failed (PORT)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "LAN_PORT", &inputLanPortNumber), L"ERROR: config file read failed (LAN_PORT)");
     ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "MAX_SESSION_COUNT", &inputMaxSessionCount), L"ERROR: config file read failed (MAX_SESSION_COUNT)");
     ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "CONCURRENT_THREAD_COUNT", &inputConcurrentThreadCount), L"ERROR: config file read failed (CONCURRENT_THREAD_COUNT)");
     ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "WORKER_THREAD_COUNT", &inputWorkerThreadCount), L"ERROR: config file read failed (WORKER_THREAD_COUNT)");
     ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "TCP_NODELAY", &inputSetTcpNodelay), L"ERROR: config file read failed (TCP_NODELAY)");
     ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SND_BUF_ZERO", &inputSetSendBufZero), L"ERROR: config file read failed (SND_BUF_ZERO)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "IOCP_PER_WORKER", &inputIocpPerWorker), L"ERROR: config file read failed (IOCP_PER_WORKER)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "IO_ENGINE", &inputIoEngine), L"ERROR: config file read failed (IO_ENGINE)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "ACCEPT_ON_WORKERS", &inputAcceptOnWorkers), L"ERROR: config file read failed (ACCEPT_ON_WORKERS)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SHARDED", &inputSharded), L"ERROR: config file read failed (SHARDED)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "WORKER_AFFINITY", &inputWorkerAffinity), L"ERROR: config file read failed (WORKER_AFFINITY)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "COMPLETION_BATCH_SIZE", &inputCompletionBatchSize), L"ERROR: config file read failed (COMPLETION_BATCH_SIZE)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_GATHER_BYTE_BUDGET", &inputSendGatherByteBudget), L"ERROR: config file read failed (SEND_GATHER_BYTE_BUDGET)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "DEFERRED_SEND_FLUSH", &inputDeferredSendFlush), L"ERROR: config file read failed (DEFERRED_SEND_FLUSH)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_LINGER_US", &inputSendLingerMicroseconds), L"ERROR: config file read failed (SEND_LINGER_US)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_LINGER_BYTES", &inputSendLingerBytes), L"ERROR: config file read failed (SEND_LINGER_BYTES)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "ZERO_COPY_RECV", &inputZeroCopyRecv), L"ERROR: config file read failed (ZERO_COPY_RECV)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "RECV_BUFFER_POOL", &inputRecvBufferPool), L"ERROR: config file read failed (RECV_BUFFER_POOL)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SLOW_CONSUMER_POLICY", &inputSlowConsumerPolicy), L"ERROR: config file read failed (SLOW_CONSUMER_POLICY)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_HIGH_WATERMARK_BYTES", &inputSendHighWatermarkBytes), L"ERROR: config file read failed (SEND_HIGH_WATERMARK_BYTES)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_LOW_WATERMARK_BYTES", &inputSendLowWatermarkBytes), L"ERROR: config file read failed (SEND_LOW_WATERMARK_BYTES)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_HIGH_WATERMARK_PACKETS", &inputSendHighWatermarkPackets), L"ERROR: config file read failed (SEND_HIGH_WATERMARK_PACKETS)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "SEND_LOW_WATERMARK_PACKETS", &inputSendLowWatermarkPackets), L"ERROR: config file read failed (SEND_LOW_WATERMARK_PACKETS)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "RECV_RATE_LIMIT_POLICY", &inputRecvRateLimitPolicy), L"ERROR: config file read failed (RECV_RATE_LIMIT_POLICY)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "RECV_PACKETS_PER_SEC", &inputRecvPacketsPerSecond), L"ERROR: config file read failed (RECV_PACKETS_PER_SEC)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "RECV_BYTES_PER_SEC", &inputRecvBytesPerSecond), L"ERROR: config file read failed (RECV_BYTES_PER_SEC)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "RECV_CHAT_MESSAGES_PER_SEC", &inputRecvChatMessagesPerSecond), L"ERROR: config file read failed (RECV_CHAT_MESSAGES_PER_SEC)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "TIMEOUT_CHECK_INTERVAL", &inputTimeoutCheckInterval), L"ERROR: config file read failed (TIMEOUT_CHECK_INTERVAL)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "TIMEOUT_LOGGED_IN", &inputTimeoutLoggedIn), L"ERROR: config file read failed (TIMEOUT_LOGGED_IN)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "TIMEOUT_NOT_LOGGED_IN", &inputTimeoutNotLoggedIn), L"ERROR: config file read failed (TIMEOUT_NOT_LOGGED_IN)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "MULTI_MESSAGE_FRAME", &inputMultiMessageFrame), L"ERROR: config file read failed (MULTI_MESSAGE_FRAME)");
+    ASSERT_LIVE(ConfigReader::GetInt("ChatServer.config", "COMPRESSION_THRESHOLD", &inputCompressionThreshold), L"ERROR: config file read failed (COMPRESSION_THRESHOLD)");
+    ASSERT_LIVE(ConfigReader::GetString("ChatServer.config", "PROTOCOL_V2_KEY", inputProtocolV2Key, sizeof(inputProtocolV2Key)), L"ERROR: config file read failed (PROTOCOL_V2_KEY)");
+    ASSERT_LIVE(inputSlowConsumerPolicy <= static_cast<uint32_t>(ESlowConsumerPolicy::DropNew), L"ERROR: invalid config (SLOW_CONSUMER_POLICY)");
+    ASSERT_LIVE(inputRecvRateLimitPolicy <= static_cast<uint32_t>(ERecvRateLimitPolicy::Disconnect), L"ERROR: invalid config (RECV_RATE_LIMIT_POLICY)");
 
     LOGF(ELogLevel::System, L"CONCURRENT_THREAD_COUNT = %u", inputConcurrentThreadCount);
     LOGF(ELogLevel::System, L"WORKER_THREAD_COUNT = %u", inputWorkerThreadCount);
@@ -44,9 +102,125 @@ int main(void)
         myChatServer.SetSendBufferSizeToZero(true);
         LOGF(ELogLevel::System, L"myChatServer.SetSendBufferSizeToZero(true)");
     }
+
+    if (inputIocpPerWorker != 0)
+    {
+        myChatServer.SetIocpPerWorker(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetIocpPerWorker(true)");
+    }
+
+    if (inputIoEngine == 1)
+    {
+        myChatServer.SetIoEngine(EIoEngine::Rio);
+        LOGF(ELogLevel::System, L"myChatServer.SetIoEngine(EIoEngine::Rio)");
+    }
+
+    if (inputAcceptOnWorkers != 0)
+    {
+        myChatServer.SetAcceptOnWorkers(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetAcceptOnWorkers(true)");
+    }
+
+    if (inputSharded != 0)
+    {
+        myChatServer.SetSharded(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetSharded(true)");
+    }
+
+    if (inputWorkerAffinity != 0)
+    {
+        myChatServer.SetWorkerAffinity(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetWorkerAffinity(true)");
+    }
+
+    myChatServer.SetCompletionBatchSize(inputCompletionBatchSize);
+    LOGF(ELogLevel::System, L"COMPLETION_BATCH_SIZE = %u", inputCompletionBatchSize);
+
+    if (inputDeferredSendFlush != 0)
+    {
+        myChatServer.SetDeferredFlush(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetDeferredFlush(true)");
+    }
+
+    if (inputSendLingerMicroseconds != 0)
+    {
+        myChatServer.SetSendLinger(inputSendLingerMicroseconds, inputSendLingerBytes);
+        LOGF(ELogLevel::System, L"myChatServer.SetSendLinger(%u us, %u bytes)", inputSendLingerMicroseconds, inputSendLingerBytes);
+    }
+
+    if (inputZeroCopyRecv != 0)
+    {
+        myChatServer.SetZeroCopyReceive(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetZeroCopyReceive(true)");
+    }
+
+    if (inputRecvBufferPool != 0)
+    {
+        myChatServer.SetPooledRecvBuffer(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetPooledRecvBuffer(true)");
+    }
+
+    if (inputSendHighWatermarkBytes != 0 || inputSendHighWatermarkPackets != 0)
+    {
+        myChatServer.SetSendBackpressure(static_cast<ESlowConsumerPolicy>(inputSlowConsumerPolicy), inputSendHighWatermarkBytes, inputSendLowWatermarkBytes, inputSendHighWatermarkPackets, inputSendLowWatermarkPackets);
+        LOGF(ELogLevel::System, L"myChatServer.SetSendBackpressure(policy %u, %u / %u bytes, %u / %u packets)", inputSlowConsumerPolicy, inputSendHighWatermarkBytes, inputSendLowWatermarkBytes, inputSendHighWatermarkPackets, inputSendLowWatermarkPackets);
+    }
+
+    if (inputRecvPacketsPerSecond != 0 || inputRecvBytesPerSecond != 0 || inputRecvChatMessagesPerSecond != 0)
+    {
+        myChatServer.SetRecvRateLimit(static_cast<ERecvRateLimitPolicy>(inputRecvRateLimitPolicy), inputRecvPacketsPerSecond, inputRecvBytesPerSecond);
+        LOGF(ELogLevel::System, L"myChatServer.SetRecvRateLimit(policy %u, %u packets/s, %u bytes/s)", inputRecvRateLimitPolicy, inputRecvPacketsPerSecond, inputRecvBytesPerSecond);
+
+        if (inputRecvChatMessagesPerSecond != 0)
+        {
+            myChatServer.AddRecvRateLimitForPacketType(en_PACKET_CS_CHAT_REQ_MESSAGE, inputRecvChatMessagesPerSecond);
+            LOGF(ELogLevel::System, L"myChatServer.AddRecvRateLimitForPacketType(en_PACKET_CS_CHAT_REQ_MESSAGE, %u packets/s)", inputRecvChatMessagesPerSecond);
+        }
+    }
     
+    // PROTOCOL_V2_KEY is 64 hex digits (32 bytes), 0 disables protocol v2
+    if (strcmp(inputProtocolV2Key, "0") != 0)
+    {
+        uint8_t protocolV2Key[NetServer::PROTOCOL_V2_KEY_SIZE];
+
+        ASSERT_LIVE(strlen(inputProtocolV2Key) == NetServer::PROTOCOL_V2_KEY_SIZE * 2, L"ERROR: invalid config (PROTOCOL_V2_KEY)");
+
+        for (uint32_t i = 0; i < NetServer::PROTOCOL_V2_KEY_SIZE; ++i)
+        {
+            unsigned int keyByte;
+            ASSERT_LIVE(sscanf_s(inputProtocolV2Key + i * 2, "%2x", &keyByte) == 1, L"ERROR: invalid config (PROTOCOL_V2_KEY)");
+            protocolV2Key[i] = static_cast<uint8_t>(keyByte);
+        }
+
+        myChatServer.SetProtocolV2Key(protocolV2Key);
+        LOGF(ELogLevel::System, L"myChatServer.SetProtocolV2Key()");
+    }
+
+    if (inputMultiMessageFrame != 0)
+    {
+        myChatServer.SetMultiMessageFrame(true);
+        LOGF(ELogLevel::System, L"myChatServer.SetMultiMessageFrame(true)");
+    }
+
+    if (inputCompressionThreshold != 0)
+    {
+        myChatServer.SetCompression(inputCompressionThreshold);
+        LOGF(ELogLevel::System, L"myChatServer.SetCompression(%u)", inputCompressionThreshold);
+    }
+
+    if (inputLanPortNumber != 0)
+    {
+        ASSERT_LIVE(myChatServer.AddListener(static_cast<uint16_t>(inputLanPortNumber), ENetworkHeaderProfile::Lan), L"ERROR: invalid config (LAN_PORT)");
+        LOGF(ELogLevel::System, L"myChatServer.AddListener(%u, ENetworkHeaderProfile::Lan)", inputLanPortNumber);
+    }
+
+    myChatServer.SetSendGatherByteBudget(inputSendGatherByteBudget);
+    LOGF(ELogLevel::System, L"SEND_GATHER_BYTE_BUDGET = %u", inputSendGatherByteBudget);
+
     myChatServer.SetMaxPayloadLength(INT16_MAX);
 
+    myChatServer.SetTimeout(inputTimeoutCheckInterval, inputTimeoutLoggedIn, inputTimeoutNotLoggedIn);
+
     // Server Run
     myChatServer.Start(static_cast<uint16_t>(inputPortNumber), inputMaxSessionCount, inputConcurrentThreadCount, inputWorkerThreadCount);
 
@@ -60,6 +234,20 @@ int main(void)
                 myChatServer.Shutdown();
                 break;
             }
+            else if (input == 'M' || input == 'm')
+            {
+                // reload MAX_SESSION_COUNT from the config file and raise the limit at runtime
+                uint32_t newMaxSessionCount;
+
+                if (ConfigReader::GetInt("ChatServer.config", "MAX_SESSION_COUNT", &newMaxSessionCount) && myChatServer.RaiseMaxSessionCount(newMaxSessionCount))
+                {
+                    LOGF(ELogLevel::System, L"MAX_SESSION_COUNT raised to %u", newMaxSessionCount);
+                }
+                else
+                {
+                    LOGF(ELogLevel::System, L"MAX_SESSION_COUNT not changed (current = %u)", myChatServer.GetMaxSessionCount());
+                }
+            }
 #ifdef PROFILE_ON
             else if (input == 'S' || input == 's')
             {
@@ -71,20 +259,103 @@ int main(void)
 
         MonitoringVariables monitoringInfo = myChatServer.GetMonitoringInfo();
 
+        ChatServer::PacketTypeStats packetTypeStats[ChatServer::PACKET_TYPE_COUNT];
+        myChatServer.CollectPacketTypeStats(packetTypeStats);
+
         LOG_MONITOR(L"\n");
         LOG_CURRENT_TIME();
         LOG_MONITOR(L"[ ChatServer Running (S: profile save) (Q: quit)]");
         LOG_MONITOR(L"=================================================");
         LOG_MONITOR(L"Session Count        = %u / %u", myChatServer.GetSessionCount(), myChatServer.GetMaxSessionCount());
+        LOG_MONITOR(L"Session Table        = %u (allocated)", myChatServer.GetAllocatedSessionCount());
         LOG_MONITOR(L"Accept Total         = %llu", myChatServer.GetTotalAcceptCount());
         LOG_MONITOR(L"Disconnected Total   = %llu", myChatServer.GetTotalDisconnectCount());
         LOG_MONITOR(L"Packet Pool Size     = %u", Serializer::GetTotalPacketCount());
+
+        if (myChatServer.IsPooledRecvBuffer())
+        {
+            LOG_MONITOR(L"Recv Buffer Pool     = %u / %u (in use / created)", monitoringInfo.RecvBufferPoolUseCount, monitoringInfo.RecvBufferPoolCapacity);
+        }
+
         LOG_MONITOR(L"---------------------- TPS ----------------------");
         LOG_MONITOR(L"Accept TPS           = %9u (Avg: %9u)", monitoringInfo.AcceptTPS, monitoringInfo.AverageAcceptTPS);
+
+        if (myChatServer.IsAcceptOnWorkers())
+        {
+            for (uint32_t i = 0; i < myChatServer.GetWorkerThreadCount() && i < MonitoringVariables::MAX_WORKER_COUNT; ++i)
+            {
+                LOG_MONITOR(L"  Worker[%2u] Accept   = %9u", i, monitoringInfo.WorkerAcceptTPS[i]);
+            }
+        }
+
         LOG_MONITOR(L"Send Message TPS     = %9u (Avg: %9u)", monitoringInfo.SendMessageTPS, monitoringInfo.AverageSendMessageTPS);
         LOG_MONITOR(L"Recv Message TPS     = %9u (Avg: %9u)", monitoringInfo.RecvMessageTPS, monitoringInfo.AverageRecvMessageTPS);
         LOG_MONITOR(L"Send Pending TPS     = %9u (Avg: %9u)", monitoringInfo.SendPendingTPS, monitoringInfo.AverageSendPendingTPS);
         LOG_MONITOR(L"Recv Pending TPS     = %9u (Avg: %9u)", monitoringInfo.RecvPendingTPS, monitoringInfo.AverageRecvPendingTPS);
+        LOG_MONITOR(L"Send Flush TPS       = %9u (Linger Expired: %9u)", monitoringInfo.SendFlushTPS, monitoringInfo.LingerFlushTPS);
+        LOG_MONITOR(L"Send Dropped TPS     = %9u (Slow Consumer Disconnect: %9u)", monitoringInfo.DroppedSendPacketTPS, monitoringInfo.SlowConsumerDisconnectTPS);
+        LOG_MONITOR(L"Recv Throttled TPS   = %9u (Rate Limit Disconnect: %9u)", monitoringInfo.ThrottledRecvPacketTPS, monitoringInfo.RateLimitDisconnectTPS);
+
+        if (myChatServer.IsZeroCopyReceive())
+        {
+            LOG_MONITOR(L"Retained View Copy   = %9u", monitoringInfo.RetainedViewCopyTPS);
+        }
+
+        LOG_MONITOR(L"Packets / Flush      = %9.2f", monitoringInfo.SendFlushTPS == 0 ? 0.0 : static_cast<double>(monitoringInfo.SendMessageTPS) / monitoringInfo.SendFlushTPS);
+
+        if (myChatServer.IsMultiMessageFrame())
+        {
+            // bytes saved = per-packet headers replaced by one frame header + 2-byte length per message
+            LOG_MONITOR(L"Multi-Msg Frame TPS  = %9u (Packets: %9u)", monitoringInfo.MultiMessageFrameTPS, monitoringInfo.MultiMessageFramePacketTPS);
+            LOG_MONITOR(L"Multi-Msg Bytes/s    = %9u (Unframed: %9u, Saved: %6.2f%%)", monitoringInfo.MultiMessageFrameBytesTPS, monitoringInfo.MultiMessageFrameUnframedBytesTPS,
+                monitoringInfo.MultiMessageFrameUnframedBytesTPS == 0 ? 0.0 : 100.0 * (static_cast<double>(monitoringInfo.MultiMessageFrameUnframedBytesTPS) - monitoringInfo.MultiMessageFrameBytesTPS) / monitoringInfo.MultiMessageFrameUnframedBytesTPS);
+        }
+
+        if (myChatServer.GetCompressionThreshold() != 0)
+        {
+            // each packet is compressed once no matter how many sessions receive it; CPU is the time spent compressing per second
+            LARGE_INTEGER performanceFrequency;
+            ::QueryPerformanceFrequency(&performanceFrequency);
+
+            LOG_MONITOR(L"Compress TPS         = %9u (Sent Compressed: %9u)", monitoringInfo.CompressTPS, monitoringInfo.CompressedSendTPS);
+            LOG_MONITOR(L"Compress Bytes/s     = %9u -> %9u (Ratio: %6.2f%%, CPU: %9.1f us/s)", monitoringInfo.CompressInputBytesTPS, monitoringInfo.CompressOutputBytesTPS,
+                monitoringInfo.CompressInputBytesTPS == 0 ? 0.0 : 100.0 * monitoringInfo.CompressOutputBytesTPS / monitoringInfo.CompressInputBytesTPS,
+                1'000'000.0 * monitoringInfo.CompressTicksTPS / performanceFrequency.QuadPart);
+        }
+
+        LOG_MONITOR(L"------------------ Packets / Send ---------------");
+
+        for (uint32_t i = 0; i < MonitoringVariables::PACKETS_PER_SEND_BUCKET_COUNT; ++i)
+        {
+            LOG_MONITOR(L"%4u ~ %4u         = %9u", 1u << i, (2u << i) - 1, monitoringInfo.PacketsPerSendHistogram[i]);
+        }
+
+        LOG_MONITOR(L"------------- Completions / Wakeup --------------");
+
+        for (uint32_t i = 0; i < MonitoringVariables::COMPLETIONS_PER_WAKEUP_BUCKET_COUNT; ++i)
+        {
+            LOG_MONITOR(L"%4u ~ %4u         = %9u", 1u << i, (2u << i) - 1, monitoringInfo.CompletionsPerWakeupHistogram[i]);
+        }
+
+        LOG_MONITOR(L"------- Handler Time (us) / Fan-out (sessions) --");
+
+        const struct { en_PACKET_TYPE Type; const WCHAR* Name; } handledPacketTypes[] =
+        {
+            { en_PACKET_CS_CHAT_REQ_LOGIN, L"LOGIN" },
+            { en_PACKET_CS_CHAT_REQ_SECTOR_MOVE, L"SECTOR_MOVE" },
+            { en_PACKET_CS_CHAT_REQ_MESSAGE, L"MESSAGE" },
+            { en_PACKET_CS_CHAT_REQ_HEARTBEAT, L"HEARTBEAT" },
+        };
+
+        for (const auto& handledPacketType : handledPacketTypes)
+        {
+            const ChatServer::PacketTypeStats& stats = packetTypeStats[handledPacketType.Type];
+
+            LOG_MONITOR(L"%-11s %8llu/s | p50 %8.2f p99 %8.2f p999 %8.2f | p50 %5llu p99 %5llu p999 %5llu", handledPacketType.Name, stats.Count,
+                stats.HandlerNanosecondsP50 / 1000.0, stats.HandlerNanosecondsP99 / 1000.0, stats.HandlerNanosecondsP999 / 1000.0,
+                stats.FanOutP50, stats.FanOutP99, stats.FanOutP999);
+        }
+
         LOG_MONITOR(L"----------------------- CPU ---------------------");
         LOG_MONITOR(L"Total  = Processor: %6.3f / Process: %6.3f", monitoringInfo.ProcessorTimeTotal, monitoringInfo.ProcessTimeTotal);
         LOG_MONITOR(L"User   = Processor: %6.3f / Process: %6.3f", monitoringInfo.ProcessorTimeUser, monitoringInfo.ProcessTimeUser);
@@ -0,0 +1,270 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <Windows.h>
+
+#include "../ChatServerMulti/NetLibrary/NetServer/Serializer.h"
+
+// Regression guard for the vectorized NET header codec in Serializer.h
+//  1. Equivalence : sumBytes / encodeFrame / decodeFrameTo against the previous scalar implementation
+//                   (every length from 0 to 99 and random lengths up to 32 KB, intact and corrupted frames)
+//  2. Throughput  : GB/s of the vectorized and scalar versions for 16 B - 32 KB payloads
+// Build with /arch:AVX2 as well to cover the AVX2 path of sumBytes
+// Returns 1 if any check fails
+
+constexpr uint32_t MAX_CHECK_LENGTH = 32 * 1024;
+constexpr uint32_t SMALL_LENGTH_REPEAT_COUNT = 16;
+constexpr uint32_t RANDOM_LENGTH_CHECK_COUNT = 2'000;
+constexpr uint64_t BENCHMARK_BYTES = 256ull * 1024 * 1024;
+
+constexpr uint32_t CHECKSUM_OFFSET = offsetof(NetNetworkHeader, CheckSum);
+
+volatile uint32_t g_sink;
+
+// Access to the private codec functions (declared as a friend of Serializer)
+class CodecBenchmark
+{
+public:
+    static uint8_t SumBytes(const char* data, const uint32_t size) { return Serializer::sumBytes(reinterpret_cast<const unsigned char*>(data), size); }
+    static void EncodeFrame(char* frame) { Serializer::encodeFrame(frame); }
+    static bool DecodeFrameTo(const char* frame, char* dest) { return Serializer::decodeFrameTo(frame, dest); }
+};
+
+// Scalar implementation before vectorization (reference)
+namespace ScalarCodec
+{
+    uint8_t CheckSum(const char* payload, const uint32_t size)
+    {
+        uint8_t checkSum = 0;
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            checkSum += payload[i];
+        }
+
+        return checkSum;
+    }
+
+    void EncodeFrame(char* frame)
+    {
+        unsigned char* encodeData = reinterpret_cast<unsigned char*>(frame) + CHECKSUM_OFFSET;
+
+        uint16_t encodeLength = *reinterpret_cast<uint16_t*>(encodeData - 3) + 1;
+
+        uint8_t randKey = *reinterpret_cast<uint8_t*>(encodeData - 1);
+
+        uint8_t nextRandKey = 0;
+        uint8_t prevEncodedValue = 0;
+
+        for (uint16_t i = 0; i < encodeLength; ++i)
+        {
+            nextRandKey = encodeData[i] ^ (nextRandKey + randKey + i + 1);
+            encodeData[i] = nextRandKey ^ (prevEncodedValue + NETWORK_HEADER_FIXED_KEY + i + 1);
+            prevEncodedValue = encodeData[i];
+        }
+    }
+
+    bool DecodeFrame(char* frame)
+    {
+        unsigned char* decodeData = reinterpret_cast<unsigned char*>(frame) + CHECKSUM_OFFSET;
+
+        uint16_t decodeLength = *reinterpret_cast<uint16_t*>(decodeData - 3) + 1;
+
+        uint8_t randKey = *reinterpret_cast<uint8_t*>(decodeData - 1);
+
+        uint8_t prevEncodedValue = 0;
+        uint8_t prevRandKey = 0;
+
+        for (uint16_t i = 0; i < decodeLength; ++i)
+        {
+            uint8_t currentRandKey = decodeData[i] ^ (prevEncodedValue + NETWORK_HEADER_FIXED_KEY + i + 1);
+            prevEncodedValue = decodeData[i];
+            decodeData[i] = currentRandKey ^ (prevRandKey + randKey + i + 1);
+            prevRandKey = currentRandKey;
+        }
+
+        return *decodeData == CheckSum(frame + sizeof(NetNetworkHeader), decodeLength - 1);
+    }
+}
+
+// Plain frame (header + random payload) with the checksum filled in
+std::vector<char> makeFrame(const uint32_t length, std::mt19937& random)
+{
+    std::vector<char> frame(sizeof(NetNetworkHeader) + length);
+
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        frame[sizeof(NetNetworkHeader) + i] = static_cast<char>(random());
+    }
+
+    NetNetworkHeader* header = reinterpret_cast<NetNetworkHeader*>(frame.data());
+    header->Code = NETWORK_HEADER_CODE;
+    header->Length = static_cast<uint16_t>(length);
+    header->RandKey = static_cast<uint8_t>(random());
+    header->CheckSum = ScalarCodec::CheckSum(frame.data() + sizeof(NetNetworkHeader), length);
+
+    return frame;
+}
+
+bool reportMismatch(const char* what, const uint32_t length)
+{
+    printf("MISMATCH: %s (length %u)\n", what, length);
+    return false;
+}
+
+// Checks one random frame of the given payload length
+bool checkLength(const uint32_t length, std::mt19937& random)
+{
+    const std::vector<char> plainFrame = makeFrame(length, random);
+    const char* payload = plainFrame.data() + sizeof(NetNetworkHeader);
+
+    if (CodecBenchmark::SumBytes(payload, length) != ScalarCodec::CheckSum(payload, length))
+    {
+        return reportMismatch("sumBytes", length);
+    }
+
+    std::vector<char> scalarEncodedFrame = plainFrame;
+    std::vector<char> encodedFrame = plainFrame;
+    ScalarCodec::EncodeFrame(scalarEncodedFrame.data());
+    CodecBenchmark::EncodeFrame(encodedFrame.data());
+
+    if (encodedFrame != scalarEncodedFrame)
+    {
+        return reportMismatch("encodeFrame", length);
+    }
+
+    // Intact frame, then the same frame with one bit flipped in [checksum + payload]
+    for (int bCorrupt = 0; bCorrupt < 2; ++bCorrupt)
+    {
+        std::vector<char> inputFrame = encodedFrame;
+
+        if (bCorrupt)
+        {
+            inputFrame[CHECKSUM_OFFSET + random() % (length + 1)] ^= static_cast<char>(1 << (random() % 8));
+        }
+
+        std::vector<char> scalarDecodedFrame = inputFrame;
+        const bool bScalarResult = ScalarCodec::DecodeFrame(scalarDecodedFrame.data());
+
+        // Decoding to a separate buffer (multi message frame, compression)
+        std::vector<char> decodedData(length + 1);
+        const bool bResult = CodecBenchmark::DecodeFrameTo(inputFrame.data(), decodedData.data());
+
+        if (bResult != bScalarResult || ::memcmp(decodedData.data(), scalarDecodedFrame.data() + CHECKSUM_OFFSET, length + 1) != 0)
+        {
+            return reportMismatch(bCorrupt ? "decodeFrameTo (corrupted)" : "decodeFrameTo", length);
+        }
+
+        // Decoding in place (receive path)
+        std::vector<char> inPlaceFrame = inputFrame;
+        const bool bInPlaceResult = CodecBenchmark::DecodeFrameTo(inPlaceFrame.data(), inPlaceFrame.data() + CHECKSUM_OFFSET);
+
+        if (bInPlaceResult != bScalarResult || inPlaceFrame != scalarDecodedFrame)
+        {
+            return reportMismatch(bCorrupt ? "decodeFrame in place (corrupted)" : "decodeFrame in place", length);
+        }
+
+        if (!bCorrupt && (!bScalarResult || scalarDecodedFrame != plainFrame))
+        {
+            return reportMismatch("encode/decode round trip", length);
+        }
+    }
+
+    return true;
+}
+
+// Calls func repeatedly over about BENCHMARK_BYTES bytes and returns GB/s
+template <typename Func>
+double measureGigaBytesPerSecond(const uint32_t length, Func func)
+{
+    const uint64_t iterationCount = BENCHMARK_BYTES / length;
+
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER begin;
+    LARGE_INTEGER end;
+
+    ::QueryPerformanceFrequency(&frequency);
+
+    // warm-up
+    func();
+
+    ::QueryPerformanceCounter(&begin);
+
+    for (uint64_t i = 0; i < iterationCount; ++i)
+    {
+        func();
+    }
+
+    ::QueryPerformanceCounter(&end);
+
+    const double seconds = static_cast<double>(end.QuadPart - begin.QuadPart) / frequency.QuadPart;
+
+    return static_cast<double>(length) * iterationCount / seconds / 1'000'000'000.0;
+}
+
+void runBenchmark(std::mt19937& random)
+{
+    const uint32_t benchmarkLengths[] = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768 };
+
+    printf("\n%8s %14s %14s %14s %14s %14s\n", "payload", "sum (simd)", "sum (scalar)", "decode (simd)", "decode (scalar)", "encode");
+
+    for (const uint32_t length : benchmarkLengths)
+    {
+        std::vector<char> frame = makeFrame(length, random);
+        CodecBenchmark::EncodeFrame(frame.data());
+
+        const char* payload = frame.data() + sizeof(NetNetworkHeader);
+        std::vector<char> workFrame = frame;
+        std::vector<char> decodedData(length + 1);
+
+        const double sumSimd = measureGigaBytesPerSecond(length, [&] { g_sink += CodecBenchmark::SumBytes(payload, length); });
+        const double sumScalar = measureGigaBytesPerSecond(length, [&] { g_sink += ScalarCodec::CheckSum(payload, length); });
+        const double decodeSimd = measureGigaBytesPerSecond(length, [&] { g_sink += CodecBenchmark::DecodeFrameTo(frame.data(), decodedData.data()); });
+
+        // Decodes in place repeatedly - the content changes every time but the cost does not
+        const double decodeScalar = measureGigaBytesPerSecond(length, [&] { g_sink += ScalarCodec::DecodeFrame(workFrame.data()); });
+        const double encode = measureGigaBytesPerSecond(length, [&] { CodecBenchmark::EncodeFrame(workFrame.data()); g_sink += workFrame[CHECKSUM_OFFSET]; });
+
+        printf("%8u %11.2f GB/s %11.2f GB/s %11.2f GB/s %11.2f GB/s %11.2f GB/s\n", length, sumSimd, sumScalar, decodeSimd, decodeScalar, encode);
+    }
+}
+
+int main(void)
+{
+    std::mt19937 random(20261016);
+
+    // Equivalence check
+    uint32_t failCount = 0;
+
+    for (uint32_t length = 0; length < 100; ++length)
+    {
+        for (uint32_t repeat = 0; repeat < SMALL_LENGTH_REPEAT_COUNT; ++repeat)
+        {
+            failCount += checkLength(length, random) ? 0 : 1;
+        }
+    }
+
+    for (uint32_t repeat = 0; repeat < RANDOM_LENGTH_CHECK_COUNT; ++repeat)
+    {
+        failCount += checkLength(random() % (MAX_CHECK_LENGTH + 1), random) ? 0 : 1;
+    }
+
+    if (failCount != 0)
+    {
+        printf("Equivalence check FAILED (%u mismatches)\n", failCount);
+        return 1;
+    }
+
+#ifdef __AVX2__
+    printf("Equivalence check passed (SSE2 + AVX2)\n");
+#else
+    printf("Equivalence check passed (SSE2)\n");
+#endif
+
+    // Throughput
+    runBenchmark(random);
+
+    return 0;
+}
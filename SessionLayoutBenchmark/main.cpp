@@ -0,0 +1,408 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <WinSock2.h>
+#include <MSWSock.h>
+#include <Windows.h>
+
+#include "../ChatServerMulti/NetLibrary/NetServer/Session.h"
+
+// Session member layout benchmark
+// Runs the member accesses of SendPacket and of the send/recv completion handling on two copies of Session
+//  - Old : the current members in the declaration order used before the cache-line layout (no alignment, neighbouring sessions share lines)
+//  - New : the current Session layout (cache-line aligned blocks grouped by writer, see Session.h)
+// Every worker thread sends to random sessions (any worker) and handles the completions of the sessions it owns (index % worker count)
+// The socket calls themselves are left out so that only the cost of the member accesses is measured
+
+constexpr uint32_t OPERATION_COUNT_PER_WORKER = 1'000'000;    // SendPacket + completion pairs per worker
+constexpr uint32_t REPEAT_COUNT = 3;                          // best of
+constexpr uint32_t MAX_REGISTERED_PACKET_COUNT = 1024;
+constexpr uint32_t PACKET_BYTES = 100;
+constexpr uint32_t SEND_HIGH_WATERMARK_BYTES = 0x7FFF'FFFF;
+constexpr uint32_t RECV_RATE_LIMIT_TYPE_COUNT = 8;
+
+volatile uint64_t g_sink;
+
+// Same size and alignment as T without constructing it (members the benchmark does not touch)
+template <typename T>
+struct Placeholder
+{
+    alignas(T) char Bytes[sizeof(T)];
+};
+
+// Current members in the order used before the cache-line layout (members added since then sit next to the ones they were added with)
+struct OldLayoutSession
+{
+    uint64_t                    ID;
+    SOCKET                      Socket;
+    SOCKADDR_IN                 Address;
+    NetServer*                  Server;
+    HANDLE                      IOCP;
+    ENetworkHeaderProfile       HeaderProfile;
+
+    OVERLAPPED                  SendOverlapped;
+    OVERLAPPED                  RecvOverlapped;
+
+    uint32_t                    IoCount;
+    uint32_t                    bSendFlag;
+    uint32_t                    bFlushRegistered;
+    uint32_t                    bLingerRegistered;
+    uint32_t                    SendQueueBytes;
+    uint32_t                    LingerMicroseconds;
+    uint32_t                    LingerBytes;
+    uint32_t                    SessionListKey;
+    bool                        bDisconnected;
+    bool                        bDisconnectRegistered;
+    bool                        bSlowConsumer;
+    bool                        bZeroByteRecv;
+    ESessionProtocol            Protocol;
+    bool                        bMultiMessageFrame;
+    bool                        bCompression;
+    uint64_t                    RecvTokenRefillMicroseconds;
+    int64_t                     RecvPacketTokens;
+    int64_t                     RecvByteTokens;
+    int64_t                     RecvTypePacketTokens[RECV_RATE_LIMIT_TYPE_COUNT];
+
+    Placeholder<SessionRecvBuffer>          RecvBuffer;
+    LockFreeQueue<Serializer*>              SendQueue;
+    Placeholder<std::deque<Serializer*>>    LocalSendQueue;
+    uint32_t                    RegisteredPacketCount;
+    uint32_t                    RegisteredPacketCapacity;
+    Serializer**                RegisteredPackets;
+    char*                       CopySendBuffer;
+    uint32_t                    CopiedPacketCount;
+    Serializer*                 PendingCopyPacket;
+    uint32_t                    PendingCopyOffset;
+    uint32_t                    CipherSendPrefixBytes;
+    Placeholder<ChaCha20>       RecvCipher;
+    Placeholder<ChaCha20>       SendCipher;
+
+    RIO_RQ                      RioRequestQueue;
+    RIO_BUFFERID                RioRecvBufferID;
+    char*                       RioSendBuffer;
+    uint32_t                    RioSendOffset;
+    SRWLOCK                     RioLock;
+};
+
+// Same blocks as Session (keep in sync with Session.h, checked by the static_assert below)
+struct NewLayoutSession
+{
+    enum
+    {
+        CACHE_LINE_SIZE = 64
+    };
+
+    alignas(CACHE_LINE_SIZE)
+    uint32_t                    IoCount;
+    uint32_t                    bSendFlag;
+    uint32_t                    bFlushRegistered;
+    uint32_t                    bLingerRegistered;
+    uint32_t                    SendQueueBytes;
+    bool                        bDisconnected;
+    bool                        bDisconnectRegistered;
+    bool                        bSlowConsumer;
+    SRWLOCK                     RioLock;
+
+    alignas(CACHE_LINE_SIZE)
+    LockFreeQueue<Serializer*>  SendQueue;
+
+    alignas(CACHE_LINE_SIZE)
+    ESessionProtocol            Protocol;
+    uint32_t                    LingerMicroseconds;
+    uint32_t                    LingerBytes;
+    bool                        bMultiMessageFrame;
+    bool                        bCompression;
+
+    alignas(CACHE_LINE_SIZE)
+    OVERLAPPED                  SendOverlapped;
+    OVERLAPPED                  RecvOverlapped;
+    uint32_t                    RegisteredPacketCount;
+    uint32_t                    RegisteredPacketCapacity;
+    Serializer**                RegisteredPackets;
+    bool                        bZeroByteRecv;
+    uint64_t                    RecvTokenRefillMicroseconds;
+    int64_t                     RecvPacketTokens;
+    int64_t                     RecvByteTokens;
+    int64_t                     RecvTypePacketTokens[RECV_RATE_LIMIT_TYPE_COUNT];
+    Placeholder<SessionRecvBuffer>          RecvBuffer;
+    Placeholder<std::deque<Serializer*>>    LocalSendQueue;
+    Placeholder<ChaCha20>       RecvCipher;
+
+    alignas(CACHE_LINE_SIZE)
+    uint32_t                    CopiedPacketCount;
+    Serializer*                 PendingCopyPacket;
+    uint32_t                    PendingCopyOffset;
+    uint32_t                    CipherSendPrefixBytes;
+    Placeholder<ChaCha20>       SendCipher;
+
+    alignas(CACHE_LINE_SIZE)
+    uint64_t                    ID;
+    SOCKET                      Socket;
+    NetServer*                  Server;
+    HANDLE                      IOCP;
+    ENetworkHeaderProfile       HeaderProfile;
+    uint32_t                    SessionListKey;
+    SOCKADDR_IN                 Address;
+    char*                       CopySendBuffer;
+
+    RIO_RQ                      RioRequestQueue;
+    RIO_BUFFERID                RioRecvBufferID;
+    char*                       RioSendBuffer;
+    uint32_t                    RioSendOffset;
+};
+
+static_assert(sizeof(NewLayoutSession) == sizeof(Session) && alignof(NewLayoutSession) == alignof(Session), "NewLayoutSession is out of sync with Session.h");
+
+inline uint64_t makeSessionID(const uint32_t index) { return (static_cast<uint64_t>(index) << 32) | 1; }
+
+// Session::PostSend - gathers the send queue into RegisteredPackets, the completion is picked up by the owner worker
+// (OVERLAPPED::Internal stands in for the completion status the kernel writes)
+template <typename SessionType>
+void postSend(SessionType& session)
+{
+    if ((session.SendQueue.GetCount() == 0 && session.PendingCopyPacket == nullptr && session.CipherSendPrefixBytes == 0) || session.bDisconnected || session.bDisconnectRegistered || session.Protocol == ESessionProtocol::Undecided)
+    {
+        return;
+    }
+
+    if (InterlockedExchange(&session.bSendFlag, 1))
+    {
+        return;
+    }
+
+    Serializer* packet;
+
+    while (session.RegisteredPacketCount < session.RegisteredPacketCapacity && session.SendQueue.TryDequeue(packet))
+    {
+        session.RegisteredPackets[session.RegisteredPacketCount++] = packet;
+    }
+
+    if (session.RegisteredPacketCount == 0)
+    {
+        InterlockedExchange(&session.bSendFlag, 0);
+        return;
+    }
+
+    ::ZeroMemory(&session.SendOverlapped, sizeof(session.SendOverlapped));
+
+    InterlockedIncrement(&session.IoCount);
+
+    // WSASend
+    InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&session.SendOverlapped.Internal), reinterpret_cast<PVOID>(1));
+}
+
+// NetServer::SendPacket (admitSendPacket, enqueueSendPacket, requestSend)
+template <typename SessionType>
+void sendPacket(SessionType& session, const uint64_t sessionID, Serializer* packet)
+{
+    const int32_t retIoCount = static_cast<int32_t>(InterlockedIncrement(&session.IoCount));
+
+    if (retIoCount < 0 || session.bDisconnected || session.bDisconnectRegistered || session.ID != sessionID)
+    {
+        InterlockedDecrement(&session.IoCount);
+        return;
+    }
+
+    g_sink += static_cast<uint64_t>(session.HeaderProfile) + reinterpret_cast<uintptr_t>(session.Server);
+
+    const uint32_t sendQueueBytes = static_cast<uint32_t>(InterlockedCompareExchange(reinterpret_cast<LONG*>(&session.SendQueueBytes), 0, 0));
+
+    if (sendQueueBytes > SEND_HIGH_WATERMARK_BYTES || InterlockedOr8(reinterpret_cast<char*>(&session.bSlowConsumer), 0) != 0)
+    {
+        InterlockedDecrement(&session.IoCount);
+        return;
+    }
+
+    InterlockedAdd(reinterpret_cast<LONG*>(&session.SendQueueBytes), static_cast<LONG>(PACKET_BYTES));
+    session.SendQueue.Enqueue(packet);
+
+    if (session.LingerMicroseconds == 0 || session.SendQueueBytes >= session.LingerBytes)
+    {
+        postSend(session);
+    }
+
+    InterlockedDecrement(&session.IoCount);
+}
+
+// NetServer::handleSendCompletion and the token refill of the receive completion, on the owner worker
+template <typename SessionType>
+void handleCompletion(SessionType& session, const uint64_t sessionID, const uint64_t nowMicroseconds)
+{
+    // recv - rate limit tokens
+    g_sink += session.ID == sessionID ? reinterpret_cast<uintptr_t>(session.Server) : 0;
+    session.RecvOverlapped.Internal = 0;
+    session.RecvTokenRefillMicroseconds = nowMicroseconds;
+    session.RecvPacketTokens -= 1'000'000;
+    session.RecvByteTokens -= PACKET_BYTES * 1'000'000;
+    session.RecvTypePacketTokens[nowMicroseconds % RECV_RATE_LIMIT_TYPE_COUNT] -= 1'000'000;
+
+    // send
+    if (InterlockedCompareExchangePointer(reinterpret_cast<PVOID volatile*>(&session.SendOverlapped.Internal), nullptr, reinterpret_cast<PVOID>(1)) == nullptr)
+    {
+        return;
+    }
+
+    uint32_t registeredPacketCount = session.RegisteredPacketCount;
+    session.RegisteredPacketCount = 0;
+
+    for (uint32_t i = 0; i < registeredPacketCount; ++i)
+    {
+        g_sink += reinterpret_cast<uintptr_t>(session.RegisteredPackets[i]);
+    }
+
+    registeredPacketCount += session.CopiedPacketCount;
+    session.CopiedPacketCount = 0;
+
+    InterlockedAdd(reinterpret_cast<LONG*>(&session.SendQueueBytes), -static_cast<LONG>(registeredPacketCount * PACKET_BYTES));
+
+    InterlockedExchange(&session.bSendFlag, 0);
+
+    postSend(session);
+
+    InterlockedDecrement(&session.IoCount);
+}
+
+template <typename SessionType>
+void workerLoop(SessionType* sessions, const uint32_t sessionCount, const uint32_t workerIndex, const uint32_t workerCount, const std::atomic<bool>& bStart)
+{
+    uint32_t randomState = 0x9E37'79B9u * (workerIndex + 1);
+    uint32_t ownedIndex = workerIndex;
+    Serializer* const packet = reinterpret_cast<Serializer*>(static_cast<uintptr_t>(0x1000 + workerIndex * 0x10));
+
+    while (!bStart.load(std::memory_order_acquire))
+    {
+        YieldProcessor();
+    }
+
+    for (uint32_t i = 0; i < OPERATION_COUNT_PER_WORKER; ++i)
+    {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+
+        const uint32_t targetIndex = randomState % sessionCount;
+        sendPacket(sessions[targetIndex], makeSessionID(targetIndex), packet);
+
+        handleCompletion(sessions[ownedIndex], makeSessionID(ownedIndex), i);
+
+        ownedIndex += workerCount;
+
+        if (ownedIndex >= sessionCount)
+        {
+            ownedIndex = workerIndex;
+        }
+    }
+}
+
+// Returns seconds for OPERATION_COUNT_PER_WORKER operations on every worker
+template <typename SessionType>
+double runOnce(const uint32_t sessionCount, const uint32_t workerCount)
+{
+    // value-initialized (zero) - the same state Session::Init leaves for the fields used here
+    SessionType* sessions = new SessionType[sessionCount]();
+
+    for (uint32_t i = 0; i < sessionCount; ++i)
+    {
+        sessions[i].ID = makeSessionID(i);
+        sessions[i].Server = reinterpret_cast<NetServer*>(static_cast<uintptr_t>(0x10000));
+        sessions[i].HeaderProfile = ENetworkHeaderProfile::Net;
+        sessions[i].Protocol = ESessionProtocol::V1;
+        sessions[i].SessionListKey = i;
+        sessions[i].RegisteredPacketCapacity = MAX_REGISTERED_PACKET_COUNT;
+        sessions[i].RegisteredPackets = new Serializer*[MAX_REGISTERED_PACKET_COUNT];
+    }
+
+    std::atomic<bool> bStart{ false };
+    std::vector<std::thread> workers;
+
+    for (uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        workers.emplace_back(workerLoop<SessionType>, sessions, sessionCount, workerIndex, workerCount, std::cref(bStart));
+        ::SetThreadAffinityMask(workers.back().native_handle(), static_cast<DWORD_PTR>(1) << (workerIndex % (sizeof(DWORD_PTR) * 8)));
+    }
+
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER begin;
+    LARGE_INTEGER end;
+
+    ::QueryPerformanceFrequency(&frequency);
+    ::QueryPerformanceCounter(&begin);
+
+    bStart.store(true, std::memory_order_release);
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    ::QueryPerformanceCounter(&end);
+
+    for (uint32_t i = 0; i < sessionCount; ++i)
+    {
+        delete[] sessions[i].RegisteredPackets;
+    }
+
+    delete[] sessions;
+
+    return static_cast<double>(end.QuadPart - begin.QuadPart) / frequency.QuadPart;
+}
+
+template <typename SessionType>
+double runBest(const uint32_t sessionCount, const uint32_t workerCount)
+{
+    double bestSeconds = runOnce<SessionType>(sessionCount, workerCount);
+
+    for (uint32_t repeat = 1; repeat < REPEAT_COUNT; ++repeat)
+    {
+        const double seconds = runOnce<SessionType>(sessionCount, workerCount);
+        bestSeconds = (seconds < bestSeconds) ? seconds : bestSeconds;
+    }
+
+    return bestSeconds;
+}
+
+int main(void)
+{
+    const uint32_t hardwareThreadCount = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+    const uint32_t sessionCounts[] = { 64, 1024, 16384 };
+
+    std::vector<uint32_t> workerCounts;
+
+    for (uint32_t workerCount = 1; workerCount < hardwareThreadCount; workerCount *= 2)
+    {
+        workerCounts.push_back(workerCount);
+    }
+
+    workerCounts.push_back(hardwareThreadCount);
+
+    printf("sizeof(Session) old %zu B / new %zu B, %u SendPacket + completion pairs per worker, best of %u\n\n",
+        sizeof(OldLayoutSession), sizeof(NewLayoutSession), OPERATION_COUNT_PER_WORKER, REPEAT_COUNT);
+    printf("%9s %8s %14s %14s %12s %12s %9s\n", "sessions", "workers", "old (ns/op)", "new (ns/op)", "old (Mop/s)", "new (Mop/s)", "speedup");
+
+    for (const uint32_t sessionCount : sessionCounts)
+    {
+        for (const uint32_t workerCount : workerCounts)
+        {
+            if (workerCount > sessionCount)
+            {
+                continue;
+            }
+
+            const double oldSeconds = runBest<OldLayoutSession>(sessionCount, workerCount);
+            const double newSeconds = runBest<NewLayoutSession>(sessionCount, workerCount);
+
+            // ns/op is per worker (time one worker spends on one SendPacket + completion pair)
+            printf("%9u %8u %14.1f %14.1f %12.2f %12.2f %8.2fx\n", sessionCount, workerCount,
+                oldSeconds * 1'000'000'000.0 / OPERATION_COUNT_PER_WORKER,
+                newSeconds * 1'000'000'000.0 / OPERATION_COUNT_PER_WORKER,
+                static_cast<double>(OPERATION_COUNT_PER_WORKER) * workerCount / oldSeconds / 1'000'000.0,
+                static_cast<double>(OPERATION_COUNT_PER_WORKER) * workerCount / newSeconds / 1'000'000.0,
+                oldSeconds / newSeconds);
+        }
+    }
+
+    return 0;
+}